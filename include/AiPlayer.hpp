@@ -0,0 +1,111 @@
+#ifndef OPENWANZER_AI_PLAYER_HPP
+#define OPENWANZER_AI_PLAYER_HPP
+
+#include <future>
+#include <vector>
+#include "ArmorLocation.hpp"
+#include "GameState.hpp"
+#include "HexCoord.hpp"
+#include "SimState.hpp"
+#include "ThreadPool.hpp"
+#include "Unit.hpp"
+
+namespace ai {
+
+// What one unit does this turn
+struct UnitOrder {
+	UnitHandle unit;
+	HexCoord moveTo;   // Its current position when it stays put
+	float facing;
+	UnitHandle target; // Null to hold fire
+	double score;
+};
+
+struct TurnPlan {
+	int side;
+	std::vector<UnitOrder> orders; // In the order they are to be carried out
+	int candidatesTotal;           // (hex, facing) options for all units
+	int candidatesEvaluated;       // Fewer when the budget ran out
+	double elapsedMs;
+
+	TurnPlan();
+};
+
+// The part of a unit planning reads
+struct UnitView {
+	UnitHandle handle;
+	int side;
+	HexCoord position;
+	float facing;
+	ArmorLocations locations;
+	int attack;
+	int weaponRange;
+	int movementPoints;
+	bool canMove;
+	bool canFire;
+	std::vector<HexCoord> reachable; // Planning side only: hexes it can end its move on
+};
+
+// Copy of everything planning reads, so the search never touches the live
+// GameState and the game can keep running while it thinks
+struct Snapshot {
+	int side;
+	std::vector<UnitView> units; // Living units of both sides
+	sim::SimState state;         // Rules copy for lookahead, LOS included
+
+	Snapshot(GameState& game, int side);
+};
+
+// Build on the main thread: runs the movement flood for each of side's units
+Snapshot takeSnapshot(GameState& game, int side);
+
+// Each unit in turn scores every reachable hex against a set of facings
+// (the six hex directions and straight at each enemy): attack odds on its
+// best target there, less the expected damage enemies that can reach it
+// next turn would deal through the arc it shows them, less its distance to
+// the nearest enemy. Hexes are spread over pool (or searched inline when
+// pool is null), closest to the enemy first; once budgetMs (<= 0 for no
+// limit) runs out the best options found so far are kept. The best few
+// are then played out on a copy of the snapshot's SimState against sampled
+// enemy return fire, and lose score by the chance the unit is destroyed.
+// Without a time cut the plan depends only on the snapshot. Sees through
+// fog of war.
+TurnPlan planTurn(const Snapshot& snapshot, ThreadPool* pool, int budgetMs);
+
+// Carry the orders out through the game rules on the main thread. Moves and
+// targets the live state no longer allows are skipped; a unit whose target
+// is already dead fires at its best remaining one. Does not end the turn.
+void applyPlan(GameState& game, const TurnPlan& plan);
+
+// battlesim::TurnPolicy planning inline without a time limit
+void playAiTurn(GameState& game, int side);
+
+// Plans a side's turn in the background so the caller's frame loop keeps
+// running: begin() once, then poll() every frame until a plan is ready.
+class AiController {
+public:
+	// threads <= 0 leaves one hardware thread for the caller
+	explicit AiController(int threads = 0);
+	~AiController();
+
+	AiController(const AiController&) = delete;
+	AiController& operator=(const AiController&) = delete;
+
+	bool thinking() const {
+		return pending_.valid();
+	}
+
+	// Snapshot game and start the search
+	void begin(GameState& game, int side, int budgetMs);
+
+	// True once the search is done; the plan is moved into plan
+	bool poll(TurnPlan& plan);
+
+private:
+	ThreadPool pool_;
+	std::future<TurnPlan> pending_;
+};
+
+} // namespace ai
+
+#endif // OPENWANZER_AI_PLAYER_HPP
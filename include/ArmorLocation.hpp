@@ -1,6 +1,9 @@
 #ifndef OPENWANZER_ARMOR_LOCATION_HPP
 #define OPENWANZER_ARMOR_LOCATION_HPP
 
+#include <array>
+#include <cstdint>
+#include <stdexcept>
 #include <string>
 
 // Simplified 5-part armor system (top-down view)
@@ -18,11 +21,13 @@ enum class ArmorLocation {
 
 std::string locationToString(ArmorLocation loc);
 
+// Armor and structure values are small, so 16 bits each keeps five
+// locations within a Unit's cache lines
 struct LocationStatus {
-	int currentArmor;
-	int maxArmor;
-	int currentStructure;
-	int maxStructure;
+	int16_t currentArmor;
+	int16_t maxArmor;
+	int16_t currentStructure;
+	int16_t maxStructure;
 	bool isDestroyed;
 
 	LocationStatus()
@@ -30,8 +35,64 @@ struct LocationStatus {
 	}
 
 	LocationStatus(int armor, int structure)
-	    : currentArmor(armor), maxArmor(armor), currentStructure(structure), maxStructure(structure), isDestroyed(false) {
+	    : currentArmor((int16_t)armor), maxArmor((int16_t)armor), currentStructure((int16_t)structure),
+	      maxStructure((int16_t)structure), isDestroyed(false) {
 	}
 };
 
+constexpr int kArmorLocationCount = 5; // Every location except NONE
+
+// Status of every armor location, stored inline and indexed by
+// ArmorLocation. Iteration visits the statuses in enum order; the location
+// of the i-th is static_cast<ArmorLocation>(i).
+class ArmorLocations {
+public:
+	using iterator = LocationStatus*;
+	using const_iterator = const LocationStatus*;
+
+	static bool contains(ArmorLocation loc) {
+		return static_cast<int>(loc) >= 0 && static_cast<int>(loc) < kArmorLocationCount;
+	}
+
+	// Unchecked: loc must not be NONE
+	LocationStatus& operator[](ArmorLocation loc) {
+		return statuses_[static_cast<int>(loc)];
+	}
+	const LocationStatus& operator[](ArmorLocation loc) const {
+		return statuses_[static_cast<int>(loc)];
+	}
+
+	// Throws std::out_of_range for NONE
+	LocationStatus& at(ArmorLocation loc) {
+		if (!contains(loc))
+			throw std::out_of_range("ArmorLocations::at");
+		return statuses_[static_cast<int>(loc)];
+	}
+	const LocationStatus& at(ArmorLocation loc) const {
+		if (!contains(loc))
+			throw std::out_of_range("ArmorLocations::at");
+		return statuses_[static_cast<int>(loc)];
+	}
+
+	int size() const {
+		return kArmorLocationCount;
+	}
+
+	iterator begin() {
+		return statuses_.data();
+	}
+	iterator end() {
+		return statuses_.data() + kArmorLocationCount;
+	}
+	const_iterator begin() const {
+		return statuses_.data();
+	}
+	const_iterator end() const {
+		return statuses_.data() + kArmorLocationCount;
+	}
+
+private:
+	std::array<LocationStatus, kArmorLocationCount> statuses_;
+};
+
 #endif
@@ -0,0 +1,46 @@
+#ifndef OPENWANZER_BATTLE_SIM_HPP
+#define OPENWANZER_BATTLE_SIM_HPP
+
+#include <cstdint>
+#include <vector>
+#include "Enums.hpp"
+#include "GameState.hpp"
+
+namespace battlesim {
+
+// Plays one side's turn: moves and attacks, without ending the turn
+using TurnPolicy = void (*)(GameState& game, int side);
+
+// Each unit advances on the nearest living enemy until it is in weapon
+// range, turns to face it, then fires at whichever enemy in range, arc and
+// line of sight has the best kill odds (expected damage breaks ties).
+// Sees through fog of war.
+void playScriptedTurn(GameState& game, int side);
+
+struct BattleSetup {
+	std::vector<UnitClass> units[2]; // Deployed around each side's start hex
+	TurnPolicy policy[2] = {playScriptedTurn, playScriptedTurn};
+	int maxTurns = 20; // A battle still undecided after this is a draw
+};
+
+struct BattleResult {
+	int winner; // 0 or 1, -1 for a draw
+	int turns;  // Turn the battle ended on
+	int unitsLeft[2];
+	std::vector<int> killTurns[2];    // Turn each unit was destroyed on, by the side that destroyed it
+	int damageDealt[2];               // Armor and structure removed, by attacking side
+	std::vector<int> attackDamage[2]; // Damage of each attack, by attacking side (0 on a miss)
+
+	BattleResult();
+};
+
+// Deploy setup on a map generated from seed and play it out. Runs on the
+// headless core only, so battles can run on any thread.
+BattleResult runBattle(const BattleSetup& setup, uint64_t seed);
+
+// Seed of battle number `battle` in a run started from baseSeed
+uint64_t battleSeed(uint64_t baseSeed, uint64_t battle);
+
+} // namespace battlesim
+
+#endif // OPENWANZER_BATTLE_SIM_HPP
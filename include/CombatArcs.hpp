@@ -11,11 +11,33 @@ enum class AttackArc { FRONT,
 	               RIGHT_SIDE,
 	               REAR };
 
+// A facing prepared for arc tests: which 30-degree bucket it falls in and
+// its direction vector. Build one per unit when testing many pairs.
+struct ArcFacing {
+	float degrees;  // Normalized to [0, 360)
+	int bucket;     // degrees / 30, 0-11
+	bool aligned;   // degrees is an exact multiple of 30
+	double dirX, dirY;
+
+	explicit ArcFacing(float facing);
+};
+
+// Arcs are resolved in hex space: the cube delta between the two hexes is
+// classed into one of twelve 30-degree sectors with integer tests, and a
+// table indexed by sector and facing bucket gives the arc. Only when an arc
+// boundary passes through the sector is the delta tested against the facing
+// vector. No pixel layout or trigonometry is involved.
+
 // Calculate which arc of the target is being attacked from
-AttackArc getAttackArc(Vector2 attackerPos, Vector2 targetPos, float targetFacing);
+AttackArc getAttackArc(const HexCoord& attacker, const HexCoord& target, const ArcFacing& targetFacing);
+AttackArc getAttackArc(const HexCoord& attacker, const HexCoord& target, float targetFacing);
 
 // Check if target is within attacker's frontal firing arc
-bool isInFiringArc(Vector2 attackerPos, float attackerFacing, Vector2 targetPos);
+bool isInFiringArc(const HexCoord& attacker, const ArcFacing& attackerFacing, const HexCoord& target);
+bool isInFiringArc(const HexCoord& attacker, float attackerFacing, const HexCoord& target);
+
+// Facing in degrees, [0, 360), that points from one hex center to another
+float facingToward(const HexCoord& from, const HexCoord& to);
 
 // Get color for attack line based on arc
 Color getLineColor(AttackArc arc);
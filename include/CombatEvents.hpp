@@ -0,0 +1,79 @@
+#ifndef OPENWANZER_COMBAT_EVENTS_HPP
+#define OPENWANZER_COMBAT_EVENTS_HPP
+
+#include <cstdint>
+#include <vector>
+#include "ArmorLocation.hpp"
+#include "CombatArcs.hpp"
+
+struct GameState;
+struct Unit;
+
+namespace combatevents {
+
+enum class CombatEventType : uint8_t {
+	ATTACK_DECLARED,    // attacker fires at defender
+	ARC_RESOLVED,       // arc
+	MISS,
+	LOCATION_HIT,       // location takes amount damage
+	ARMOR_ABSORBED,     // location armor before -> after, absorbing amount; overflow goes on to structure
+	STRUCTURE_DAMAGED,  // location structure before -> after, absorbing amount
+	LOCATION_DESTROYED, // location
+	DAMAGE_TRANSFERRED, // amount carried over from location to transferTo
+	LOCATION_STATUS,    // location left with armor and structure
+	UNIT_DESTROYED,
+	ATTACK_RESOLVED     // A hit has been fully applied
+};
+
+// One step of attack resolution. Only the fields listed for the type are
+// meaningful. Damage events raised by a transfer have transferred set, so
+// presentation can tell them from the location originally hit.
+struct CombatEvent {
+	CombatEventType type;
+	Unit* attacker;
+	Unit* defender;
+	ArmorLocation location;
+	ArmorLocation transferTo;
+	combatarcs::AttackArc arc;
+	int amount;
+	int before;
+	int after;
+	int overflow;
+	int armor;     // LOCATION_STATUS: what the location has left
+	int structure;
+	bool transferred;
+
+	CombatEvent(CombatEventType type_, Unit* attacker_, Unit* defender_)
+	    : type(type_), attacker(attacker_), defender(defender_), location(ArmorLocation::NONE),
+	      transferTo(ArmorLocation::NONE), arc(combatarcs::AttackArc::FRONT), amount(0), before(0), after(0),
+	      overflow(0), armor(0), structure(0), transferred(false) {
+	}
+};
+
+using CombatEventHandler = void (*)(GameState& game, const CombatEvent& event);
+
+// Events raised during the current turn, in order. Handlers run as each
+// event is emitted; with none subscribed (headless play), emitting is just
+// an append.
+class CombatEventStream {
+public:
+	void subscribe(CombatEventHandler handler);
+	void emit(GameState& game, const CombatEvent& event);
+
+	// Called at the end of each turn
+	void clear() {
+		events_.clear();
+	}
+
+	const std::vector<CombatEvent>& events() const {
+		return events_;
+	}
+
+private:
+	std::vector<CombatEvent> events_;
+	std::vector<CombatEventHandler> handlers_;
+};
+
+} // namespace combatevents
+
+#endif // OPENWANZER_COMBAT_EVENTS_HPP
@@ -0,0 +1,156 @@
+#ifndef OPENWANZER_COMBAT_LOG_STORE_HPP
+#define OPENWANZER_COMBAT_LOG_STORE_HPP
+
+#include <cstdint>
+#include <cstdio>
+#include <initializer_list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace combatlog {
+
+// Message templates. %d is replaced by a numeric argument, %s by an
+// interned string argument.
+enum class LogTemplate : uint16_t {
+	BATTLE_START,       // === Battle Start ===
+	TURN_HEADER,        // --- Turn %d ---
+	TURN_BEGINS,        // %s turn begins
+	TURN_ENDED,         // %s turn ended
+	SEPARATOR,          // ---
+	ALREADY_FIRED,      // Unit has already fired this turn
+	FIRES_AT,           // [COMBAT] %s (%s) fires at %s (%s)
+	OUT_OF_RANGE,       // [COMBAT] Target out of range
+	ATTACK_ARC,         // [HIT LOCATION] Attack from %s arc
+	MISS,               // [COMBAT] MISS!
+	HIT_LOCATION,       // [HIT LOCATION] Hit: %s
+	UNIT_DESTROYED,     // [COMBAT RESULT] %s (%s) DESTROYED!
+	UNIT_DAMAGED,       // [COMBAT RESULT] %s (%s) damaged
+	DAMAGE_TAKEN,       // [DAMAGE] %d damage to %s
+	ARMOR_DAMAGE,       // [DAMAGE] %s armor: %d -> %d (absorbed %d)
+	STRUCTURE_OVERFLOW, // [DAMAGE] %d overflow to structure
+	STRUCTURE_DAMAGE,   // [DAMAGE] %s structure: %d -> %d (absorbed %d)
+	LOCATION_DESTROYED, // [LOCATION DESTROYED] %s destroyed!
+	MECH_DEATH,         // [MECH DEATH] Center destroyed!
+	DAMAGE_TRANSFER,    // [DAMAGE TRANSFER] %d overflow -> %s
+	LOCATION_STATUS,    // [LOCATION STATUS] %s: %d/%d armor, %d/%d structure
+	IMPASSABLE,         // Terrain is impassable
+	UNIT_MOVES,         // %s (%s) moves to (%d,%d)
+	NOT_ENOUGH_MOVES,   // Not enough movement points
+	COUNT
+};
+
+constexpr int kMaxLogArgs = 6;
+
+// One log entry: 32 bytes, no heap storage. String arguments are ids into
+// the store's string stream.
+struct LogRecord {
+	uint16_t templateId;
+	uint16_t count; // Consecutive repeats folded into this record
+	int32_t turn;
+	int32_t args[kMaxLogArgs];
+};
+
+// A message argument: a number, or text to be interned
+struct LogArg {
+	LogArg(int value_)
+	    : value(value_), isText(false) {
+	}
+	LogArg(const char* text_)
+	    : value(0), text(text_), isText(true) {
+	}
+	LogArg(const std::string& text_)
+	    : value(0), text(text_), isText(true) {
+	}
+
+	int value;
+	std::string_view text;
+	bool isText;
+};
+
+// Bounded combat log. The newest capacity records live in a ring buffer;
+// older ones are appended to an anonymous temporary file in sequence order
+// and paged back in on demand, so memory stays constant however long the
+// game runs. Records are addressed by sequence number, 0 being the first
+// record ever pushed.
+//
+// String arguments are interned into an append-only stream of
+// NUL-terminated strings; a string's id is its byte offset. The tail of the
+// stream is kept in memory and flushed to a second temp file when it
+// outgrows kStringBuffer, and both the dedup table and the cache of strings
+// read back are bounded, so a name can be stored more than once but memory
+// never grows with the game.
+class LogStore {
+public:
+	static constexpr int kDefaultCapacity = 1024;
+	static constexpr int kPageSize = 128; // Records per spill read
+	static constexpr int kStringBuffer = 4096; // Stream bytes kept before a flush
+	static constexpr int kMaxCachedStrings = 256; // Per table (dedup, read back)
+
+	explicit LogStore(int capacity = kDefaultCapacity);
+	~LogStore();
+
+	LogStore(const LogStore&) = delete;
+	LogStore& operator=(const LogStore&) = delete;
+
+	// Append a record, or bump the newest record's count if it is identical.
+	// Returns false in the repeat case.
+	bool push(LogTemplate id, int turn, std::initializer_list<LogArg> args);
+
+	// Drop every record (the string stream is kept)
+	void clear();
+
+	// Total records pushed, including spilled ones
+	int size() const {
+		return total_;
+	}
+	bool empty() const {
+		return total_ == 0;
+	}
+	// Sequence number of the oldest record still in memory
+	int firstResident() const {
+		return total_ - resident_;
+	}
+
+	const LogRecord& back() const {
+		return ring_[slot(total_ - 1)];
+	}
+
+	// Fetch record seq, reading it back from the spill file if it has been
+	// evicted. Returns false if it could not be read.
+	bool get(int seq, LogRecord& out) const;
+
+	// Expand a record's template into text (without turn or count)
+	void format(const LogRecord& record, std::string& out) const;
+
+private:
+	std::vector<LogRecord> ring_;
+	int resident_;
+	int total_;
+
+	// String stream: bytes [0, flushed_) are in stringFile_, the rest in
+	// pending_
+	std::FILE* stringFile_;
+	int flushed_;
+	std::string pending_;
+	std::unordered_map<std::string, int> recentIds_;  // Text -> id of recent interns
+	mutable std::unordered_map<int, std::string> readBack_; // Flushed strings read back
+
+	// Spill file and the last page read back from it
+	std::FILE* spill_;
+	int spilled_;
+	mutable std::vector<LogRecord> page_;
+	mutable int pageFirst_;
+
+	int slot(int seq) const {
+		return seq % (int)ring_.size();
+	}
+	int intern(std::string_view text);
+	const std::string* lookup(int id) const; // nullptr if unreadable
+	void spill(const LogRecord& record);
+};
+
+} // namespace combatlog
+
+#endif // OPENWANZER_COMBAT_LOG_STORE_HPP
@@ -7,7 +7,26 @@
 
 namespace damagesystem {
 
-void applyDamageToLocation(GameState& game, Unit* target, ArmorLocation location, int damage);
+// What one hit did to a single location, before any transfer
+struct LocationDamage {
+	bool hitArmor;     // Location had armor left
+	bool hitStructure; // Damage reached remaining structure
+	int armorAbsorbed;
+	int structureAbsorbed;
+	int overflow; // Damage left after armor and structure
+	bool destroyed; // This hit destroyed the location
+};
+
+// The damage rules for one location, with no events
+LocationDamage damageLocation(LocationStatus& loc, int damage);
+
+// Apply a hit and any transfer it causes, with no events. Returns the
+// armor and structure removed. Used for previews and odds.
+int applyDamage(ArmorLocations& locations, ArmorLocation location, int damage);
+
+// Raises LOCATION_HIT through LOCATION_STATUS events on game.combatEvents.
+// transferred marks damage carried over from a destroyed location.
+void applyDamageToLocation(GameState& game, Unit* target, ArmorLocation location, int damage, bool transferred = false);
 ArmorLocation getTransferLocation(ArmorLocation destroyed);
 
 } // namespace damagesystem
@@ -4,7 +4,6 @@
 #include <string>
 #include <vector>
 #include "Enums.hpp"
-#include "GameHex.hpp"
 #include "GameState.hpp"
 #include "Hex.hpp"
 #include "HexCoord.hpp"
@@ -33,11 +32,13 @@ bool isRecon(const Unit* unit);
 
 // Hex math and helpers
 int hexDistance(const HexCoord& a, const HexCoord& b);
-std::vector<HexCoord> getAdjacent(int row, int col);
-std::vector<HexCoord> getCellsInRange(int row, int col, int range);
+bool getRangeRowSpan(const HexCoord& center, int range, int row, int& colMin, int& colMax);
+void getCellsInRange(int row, int col, int range, std::vector<HexCoord>& out);
 
-// Combat log helpers
-void addLogMessage(GameState& game, const std::string& message);
+// Combat log helpers (arguments fill the template's %d/%s slots in order)
+void addLogMessage(GameState& game, combatlog::LogTemplate id, std::initializer_list<combatlog::LogArg> args = {});
+// Combat event subscriber that writes attack results to the log
+void logCombatEvent(GameState& game, const combatevents::CombatEvent& event);
 
 // ============================================================================
 // PATHFINDING (pathfinding.cpp)
@@ -46,12 +47,30 @@ void addLogMessage(GameState& game, const std::string& message);
 std::vector<HexCoord> findPath(GameState& game, Unit* unit,
                                const HexCoord& start, const HexCoord& goal);
 
+// Movement range of unit, recomputed only when the unit, occupancy or
+// terrain changed since the last call
+const ReachabilityField& getReachability(GameState& game, const Unit* unit);
+
 void highlightMovementRange(GameState& game, Unit* unit);
 
 void highlightAttackRange(GameState& game, Unit* unit);
 
+// Movement points unit spends entering terrain (a getTerrainIndex value):
+// all it has left on difficult terrain, 255 or more if impassable
+int enterCost(const Unit& unit, int terrainIndex);
+
+// Records the move in game.moveHistory
 void moveUnit(GameState& game, Unit* unit, const HexCoord& target, bool updateSpotting = true);
 
+// Finish a move made with updateSpotting = false: set the facing and move
+// the unit's spotting
+void confirmMove(GameState& game, Unit* unit, float facing);
+
+// Step through game.moveHistory; the unit moved, or nullptr if there was
+// nothing to undo/redo
+Unit* undoMove(GameState& game);
+Unit* redoMove(GameState& game);
+
 // ============================================================================
 // COMBAT (combat.cpp)
 // ============================================================================
@@ -65,9 +84,17 @@ void performAttack(GameState& game, Unit* attacker, Unit* defender);
 // ============================================================================
 
 // Fog of War / Spotting
+// A unit spots every hex within spotRange it has line of sight to. Its
+// contribution is cached on the unit and only the difference to the
+// previous one is applied; flips are appended to game.visibilityChanges.
 void setUnitSpotRange(GameState& game, Unit* unit, bool on);
-void setSpotRangeAtPosition(GameState& game, int side, int spotRange, const HexCoord& pos, bool on);
+void updateUnitSight(GameState& game, Unit* unit); // Recompute if position/range/terrain changed
+void clearUnitSight(GameState& game, Unit* unit);
+void refreshAllSight(GameState& game);
 void initializeAllSpotting(GameState& game);
+bool hasLineOfSight(GameState& game, const HexCoord& from, const HexCoord& to);
+// Rebuild the LOS opacity plane if terrain changed since it was built
+void syncSightTerrain(GameState& game);
 
 // Turn management
 void endTurn(GameState& game);
@@ -83,6 +110,8 @@ void updateAttackLines(GameState& game);
 // ============================================================================
 
 void spawnCombatText(GameState& game, const HexCoord& targetHex, const std::string& text, bool isStructure);
+// Combat event subscriber that floats MISS and damage numbers over the target
+void showCombatEventText(GameState& game, const combatevents::CombatEvent& event);
 void updateCombatTexts(GameState& game, float deltaTime);
 
 } // namespace gamelogic
@@ -2,12 +2,24 @@
 #define OPENWANZER_GAME_STATE_HPP
 
 #include "CombatArcs.hpp"
-#include "GameHex.hpp"
+#include "CombatEvents.hpp"
+#include "CombatLogStore.hpp"
+#include "Constants.hpp"
 #include "HexCoord.hpp"
+#include "HexMap.hpp"
+#include "LineOfSight.hpp"
 #include "MechLoadout.hpp"
+#include "OddsEngine.hpp"
+#include "PathEngine.hpp"
+#include "Random.hpp"
 #include "Raylib.hpp"
+#include "TerrainMesh.hpp"
 #include "Unit.hpp"
+#include "UnitStore.hpp"
+#include "Visibility.hpp"
 
+#include <cstdio>
+#include <deque>
 #include <memory>
 #include <string>
 #include <vector>
@@ -51,8 +63,12 @@ struct VideoSettings {
 	float combatTextFloatTime;  // Duration of float-up + fade-out phase
 	float combatTextFloatSpeed; // Pixels per second during float (30fps * 1px/frame = 30px/s)
 
+	// Computer opponent
+	bool aiOpponent;    // Side 1 plays itself
+	int aiTurnBudgetMs; // Search time per AI turn (0 = until done)
+
 	VideoSettings()
-	    : resolutionIndex(6), fullscreen(true), vsync(false), fpsIndex(6), hexSize(65.0f), resolutionDropdownEdit(false), fpsDropdownEdit(false), combatTextFadeInTime(0.17f), combatTextFloatTime(0.33f), combatTextFloatSpeed(30.0f) {
+	    : resolutionIndex(6), fullscreen(true), vsync(false), fpsIndex(6), hexSize(65.0f), resolutionDropdownEdit(false), fpsDropdownEdit(false), combatTextFadeInTime(0.17f), combatTextFloatTime(0.33f), combatTextFloatSpeed(30.0f), aiOpponent(true), aiTurnBudgetMs(500) {
 	}
 };
 
@@ -81,20 +97,56 @@ extern const int RESOLUTION_COUNT;
 extern const int FPS_VALUES[];
 extern const char *FPS_LABELS;
 
-// Combat Log Message
-struct LogMessage {
-	int turn;
-	std::string message;
-	int count;
-
-	LogMessage(int t, const std::string &msg)
-	    : turn(t), message(msg), count(1) {
+// Word-wrapped combat log lines. Every record's line count is worked out
+// once when it arrives (again only if the text width changes) and kept as
+// cumulative line offsets; the wrapped text itself is cached only for a
+// window of records around the visible lines. Like the records, only the
+// newest kMaxResidentOffsets offsets stay in memory; older ones go to a
+// temp file, so the layout doesn't grow with the game either.
+struct CombatLogLayout {
+	static constexpr int kCacheMargin = 32;     // Extra records wrapped on either side of the view
+	static constexpr int kMaxCachedRecords = 256;
+	static constexpr int kMaxResidentOffsets = 2048;
+
+	std::deque<int> lineStart;      // First line of records [baseRecord, recordCount()), plus end
+	int baseRecord;                 // Records before this have their offset in offsetSpill
+	std::FILE *offsetSpill;         // First line of each spilled record, one int per record
+	std::vector<std::string> lines; // Wrapped lines of records [cacheFirst, cacheEnd)
+	int cacheFirst;
+	int cacheEnd;
+	int lastCount;   // Repeat count the newest record was wrapped with
+	float wrapWidth; // Text width the lines were wrapped to
+
+	CombatLogLayout();
+	~CombatLogLayout();
+
+	CombatLogLayout(const CombatLogLayout &) = delete;
+	CombatLogLayout &operator=(const CombatLogLayout &) = delete;
+
+	int recordCount() const {
+		return baseRecord + (int)lineStart.size() - 1;
+	}
+	int lineCount() const {
+		return lineStart.back();
 	}
+
+	// First line of record (recordCount() gives lineCount())
+	int lineOf(int record) const;
+	// Last record starting at or before line
+	int recordAt(int line) const;
+
+	// Add the newest record / drop it again to re-wrap it
+	void append(int recordLines);
+	void popBack();
+
+	void clear();
+	void dropCache();
 };
 
 // Combat Log Display
 struct CombatLog {
-	std::vector<LogMessage> messages;
+	combatlog::LogStore records;
+	CombatLogLayout layout;
 	float scrollOffset;      // Current scroll position (0 = top, higher = scrolled down more)
 	float maxScrollOffset;   // Maximum scroll offset
 	Rectangle bounds;        // Display area
@@ -128,29 +180,113 @@ struct UnitInfoBox {
 // Movement selection state (for two-phase selection system)
 // Phase 1: Select unit, show movement range
 // Phase 2: Unit has moved, selecting facing direction
+// Undo of the tentative move goes through GameState::moveHistory
 struct MovementSelection {
 	bool isFacingSelection; // Phase 2: unit has moved, now selecting facing
-	HexCoord oldPosition;   // Position before move (for undo)
-	int oldMovesLeft;       // Movement points before move (for undo)
-	bool oldHasMoved;       // hasMoved state before move (for undo)
 	float selectedFacing;   // The facing direction being previewed (0-360 degrees)
 
 	MovementSelection()
-	    : isFacingSelection(false), oldPosition {-1, -1}, oldMovesLeft(0), oldHasMoved(false), selectedFacing(0.0f) {
+	    : isFacingSelection(false), selectedFacing(0.0f) {
 	}
 
 	void reset();
 };
 
+// One move: what undo restores and redo puts back
+struct MoveRecord {
+	UnitHandle unit;
+	HexCoord from;
+	HexCoord to;
+	int movesLeftBefore;
+	int movesLeftAfter;
+	bool hasMovedBefore;
+	float facingBefore;
+	float facingAfter; // Updated when the facing is confirmed
+};
+
+// The current side's moves this turn, for multi-level undo/redo. Records
+// past the cursor have been undone and can be redone until a new move
+// drops them. Cleared at end of turn and by anything that can't be taken
+// back: an attack, or a move that spots an enemy unit.
+class MoveHistory {
+public:
+	MoveHistory()
+	    : cursor_(0) {
+	}
+
+	void push(const MoveRecord &record);
+	// Step back / forward; the record to revert or reapply, nullptr if none
+	const MoveRecord *undo();
+	const MoveRecord *redo();
+	// Most recent move still applied
+	MoveRecord *last() {
+		return cursor_ > 0 ? &records_[cursor_ - 1] : nullptr;
+	}
+
+	bool canUndo() const {
+		return cursor_ > 0;
+	}
+	bool canRedo() const {
+		return cursor_ < records_.size();
+	}
+	void clear() {
+		records_.clear();
+		cursor_ = 0;
+	}
+
+private:
+	std::vector<MoveRecord> records_;
+	size_t cursor_;
+};
+
+// Movement reachability of one unit: cost-so-far and parent per hex from a
+// single flood fill. Built when a unit is selected and reused by the
+// movement highlight, outline, path preview and click-to-move until the
+// unit, occupancy or terrain changes.
+struct ReachabilityField {
+	pathengine::PathEngine search; // Flood result (indexed row * MAP_COLS + col)
+	UnitHandle unit;               // Unit the field was built for
+	HexCoord origin;               // Unit position at build time
+	int movesLeft;                 // Movement budget at build time
+	unsigned int terrainRevision;  // Map/GameState revisions at build time
+	unsigned int occupancyRevision;
+	bool valid;
+
+	ReachabilityField()
+	    : origin {-1, -1}, movesLeft(0), terrainRevision(0), occupancyRevision(0), valid(false) {
+	}
+
+	bool reaches(const HexCoord &coord) const {
+		return valid && search.inBounds(coord) && search.reached(search.index(coord));
+	}
+
+	// Writes origin..coord path into out (empty if coord is unreachable)
+	void pathTo(const HexCoord &coord, std::vector<HexCoord> &out) const;
+
+	void invalidate() {
+		valid = false;
+		unit = UnitHandle();
+	}
+};
+
+// A hex whose fog-of-war state flipped for one side
+struct VisibilityChange {
+	HexCoord hex;
+	int side;
+	bool visible; // true = became spotted, false = became hidden
+};
+
 // Attack line structure for visualizing firing lines
 struct AttackLine {
 	HexCoord from;
 	HexCoord to;
 	combatarcs::AttackArc arc;
 	bool outOfRange;
+	odds::AttackOdds odds; // Outcome of firing along this line
 
-	AttackLine(HexCoord f, HexCoord t, combatarcs::AttackArc a, bool oor = false)
-	    : from(f), to(t), arc(a), outOfRange(oor) {
+	AttackLine(HexCoord f, HexCoord t, combatarcs::AttackArc a, bool oor = false,
+	           const odds::AttackOdds &o = odds::AttackOdds())
+	    : from(f), to(t), arc(a), outOfRange(oor), odds(o) {
 	}
 };
 
@@ -223,19 +359,45 @@ struct PaperdollPanel {
 };
 
 struct TargetPanel : public PaperdollPanel {
-	Unit *targetUnit;
+	UnitHandle targetUnit;
 	combatarcs::AttackArc currentArc; // For red line indicators
 
 	TargetPanel()
-	    : targetUnit(nullptr), currentArc(combatarcs::AttackArc::FRONT) {
+	    : currentArc(combatarcs::AttackArc::FRONT) {
 	}
 };
 
 struct PlayerPanel : public PaperdollPanel {
-	Unit *playerUnit;
+	UnitHandle playerUnit;
+};
+
+// Terrain layer (fills + grid) pre-rendered into fixed-size texture tiles
+// for one zoom level and hex size. Tiles cover the terrain mesh bounds and
+// are rendered the first time they come on screen; panning only moves where
+// they are drawn. Textures are GPU resources: release them with
+// rendering::unloadTerrainCache before the window closes.
+struct TerrainLayerCache {
+	static constexpr int kTileSize = 1024;
+	// Tiles kept loaded once off screen (4 MB each). At most this many, or
+	// the number on screen if that is larger, are loaded at once; beyond it
+	// the least recently shown off-screen tile is unloaded.
+	static constexpr int kMaxLoadedTiles = 16;
+
+	std::vector<RenderTexture2D> tiles; // Row-major, id 0 = not rendered yet
+	std::vector<unsigned int> lastShown; // Per tile, frame it was last on screen
+	unsigned int frame;
+	int loadedTiles;
+	int tileCols;
+	int tileRows;
+	float originX; // Tile (0, 0) top-left relative to the camera offset
+	float originY;
+	float zoom; // Key: rebuilt when any of these change
+	float hexSize;
+	unsigned int terrainRevision;
+	bool valid;
 
-	PlayerPanel()
-	    : playerUnit(nullptr) {
+	TerrainLayerCache()
+	    : frame(0), loadedTiles(0), tileCols(0), tileRows(0), originX(0.0f), originY(0.0f), zoom(0.0f), hexSize(0.0f), terrainRevision(0), valid(false) {
 	}
 };
 
@@ -293,11 +455,21 @@ struct CombatText {
 	}
 };
 
+struct GameState;
+using GameHook = void (*)(GameState &game);
+
+// Presentation callbacks the rules invoke. All optional: headless runs
+// leave them null.
+struct GameHooks {
+	GameHook turnEnded = nullptr; // After endTurn has reset the new side's units
+};
+
 // Game State
 struct GameState {
-	std::vector<std::vector<GameHex>> map;
-	std::vector<std::unique_ptr<Unit>> units;
-	Unit *selectedUnit;
+	HexMap map;
+	UnitStore units;
+	std::vector<Unit *> occupancy; // Living unit per hex (row * MAP_COLS + col), nullptr if empty
+	UnitHandle selected;           // Selected unit (resolve with selectedUnit())
 	int currentTurn;
 	int currentPlayer; // 0 or 1
 	int maxTurns;
@@ -310,23 +482,58 @@ struct GameState {
 	CombatLog combatLog;
 	UnitInfoBox unitInfoBox;
 	MovementSelection movementSel;       // Two-phase selection state
+	MoveHistory moveHistory;             // This turn's moves, for undo/redo
 	std::vector<AttackLine> attackLines; // Active attack lines to display
 	bool showAttackLines;                // Whether to show attack lines
 	TargetPanel targetPanel;             // HBS-style target mech panel
 	PlayerPanel playerPanel;             // HBS-style player mech panel
 	std::vector<CombatText> combatTexts; // Floating damage numbers
+	pathengine::PathEngine pathEngine;   // Reusable scratch buffers for findPath
+	ReachabilityField reachability;      // Cached movement range of the selected unit
+	std::vector<VisibilityChange> visibilityChanges; // FOW flips this turn (renderer/AI)
+	combatevents::CombatEventStream combatEvents;    // Attack resolution steps this turn
+	rng::RandomService random;                       // Seeded streams for combat and effects
+	GameHooks hooks;
+	odds::OddsCache oddsCache;                       // Attack odds per (attacker, target, arc)
+
+	visibility::HexBitset sideUnits[2]; // Living unit positions per side (fog-of-war queries)
+	los::SightEngine sight; // Terrain opacity + LOS stencils
+	TerrainMesh terrainMesh; // Map-space fills + grid, rebuilt on terrain/hex size change
+	TerrainLayerCache terrainCache; // terrainMesh rendered to textures at the current zoom
+
+	// Bumped whenever unit occupancy changes; cached per-map results
+	// (reachability) compare against this and map.terrainRevision()
+	unsigned int occupancyRevision;
 
 	// MechBay loadout management
 	std::unique_ptr<mechloadout::MechLoadout> mechLoadout;
 
-	GameState();
+	explicit GameState(uint64_t seed = rng::kDefaultSeed);
 
 	void initializeMap();
 	void initializeMechBay(); // Initialize MechBay with mock data
 
 	Unit *getUnitAt(const HexCoord &coord);
+	Unit *selectedUnit() {
+		return units.get(selected);
+	}
+
+	// Null handle (and no unit) if the hex is off the map or occupied
+	UnitHandle addUnit(UnitClass uClass, int side, int row, int col);
 
-	void addUnit(UnitClass uClass, int side, int row, int col);
+	// Occupancy index maintenance - all unit position changes and deaths go
+	// through these so getUnitAt stays O(1)
+	void relocateUnit(Unit *unit, const HexCoord &target);
+	void removeUnitFromMap(Unit *unit);
+
+	// Fog-of-war queries
+	bool isSpotted(int side, const HexCoord &coord) const {
+		return map.spotting(side).isVisible(map.index(coord));
+	}
+	void newlyVisibleHexes(int side, visibility::HexBitset &out) const;  // Spotted since side's turn began
+	void hexesSeenByBothSides(visibility::HexBitset &out) const;
+	void unspottedEnemyHexes(int side, visibility::HexBitset &out) const; // Enemy units side cannot see
+	void spottedEnemyHexes(int side, visibility::HexBitset &out) const;   // Enemy units side can see
 };
 
 #endif // OPENWANZER_GAME_STATE_HPP
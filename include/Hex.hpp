@@ -1,6 +1,7 @@
 #ifndef OPENWANZER_HEX_HPP
 #define OPENWANZER_HEX_HPP
 
+#include <array>
 #include <cmath>
 #include <vector>
 #include <algorithm>
@@ -82,8 +83,8 @@ struct OffsetCoord {
 struct Point {
     double x, y;
 
-    Point(double x_, double y_) : x(x_), y(y_) {}
-    Point() : x(0), y(0) {}
+    constexpr Point(double x_, double y_) : x(x_), y(y_) {}
+    constexpr Point() : x(0), y(0) {}
 };
 
 // ============================================================================
@@ -132,53 +133,77 @@ inline OffsetCoord CubeToOffset(Hex hex) {
 // ============================================================================
 // Layout and orientation
 // ============================================================================
+constexpr double kSqrt3 = 1.7320508075688772;
+
+// Unit-circle offsets of the six corners, in corner order
+using CornerTable = std::array<Point, 6>;
+
 struct Orientation {
     double f0, f1, f2, f3;  // forward matrix
     double b0, b1, b2, b3;  // backward matrix
     double startAngle;      // in multiples of 60 degrees
+    CornerTable corners;    // cos/sin of 60 * (startAngle + i) degrees
 
-    Orientation(double f0_, double f1_, double f2_, double f3_,
-                double b0_, double b1_, double b2_, double b3_,
-                double startAngle_)
+    constexpr Orientation(double f0_, double f1_, double f2_, double f3_,
+                          double b0_, double b1_, double b2_, double b3_,
+                          double startAngle_, const CornerTable& corners_)
         : f0(f0_), f1(f1_), f2(f2_), f3(f3_),
           b0(b0_), b1(b1_), b2(b2_), b3(b3_),
-          startAngle(startAngle_) {}
+          startAngle(startAngle_), corners(corners_) {}
 };
 
 // Flat-topped hexagons
-const Orientation kLayoutFlat = Orientation(
-    3.0 / 2.0, 0.0, sqrt(3.0) / 2.0, sqrt(3.0),
-    2.0 / 3.0, 0.0, -1.0 / 3.0, sqrt(3.0) / 3.0,
-    0.0
+constexpr Orientation kLayoutFlat = Orientation(
+    3.0 / 2.0, 0.0, kSqrt3 / 2.0, kSqrt3,
+    2.0 / 3.0, 0.0, -1.0 / 3.0, kSqrt3 / 3.0,
+    0.0,
+    CornerTable{{
+        {1.0, 0.0}, {0.5, kSqrt3 / 2.0}, {-0.5, kSqrt3 / 2.0},
+        {-1.0, 0.0}, {-0.5, -kSqrt3 / 2.0}, {0.5, -kSqrt3 / 2.0}
+    }}
 );
 
 // Pointy-topped hexagons
-const Orientation kLayoutPointy = Orientation(
-    sqrt(3.0), sqrt(3.0) / 2.0, 0.0, 3.0 / 2.0,
-    sqrt(3.0) / 3.0, -1.0 / 3.0, 0.0, 2.0 / 3.0,
-    0.5
+constexpr Orientation kLayoutPointy = Orientation(
+    kSqrt3, kSqrt3 / 2.0, 0.0, 3.0 / 2.0,
+    kSqrt3 / 3.0, -1.0 / 3.0, 0.0, 2.0 / 3.0,
+    0.5,
+    CornerTable{{
+        {kSqrt3 / 2.0, 0.5}, {0.0, 1.0}, {-kSqrt3 / 2.0, 0.5},
+        {-kSqrt3 / 2.0, -0.5}, {0.0, -1.0}, {kSqrt3 / 2.0, -0.5}
+    }}
 );
 
+constexpr CornerTable ScaleCorners(const CornerTable& unit, Point size) {
+    CornerTable scaled{};
+    for (int i = 0; i < 6; i++) {
+        scaled[i] = Point(unit[i].x * size.x, unit[i].y * size.y);
+    }
+    return scaled;
+}
+
 struct Layout {
     Orientation orientation;
     Point size;
     Point origin;
+    CornerTable cornerOffsets;  // Orientation corners scaled by size
 
-    Layout(Orientation orientation_, Point size_, Point origin_)
-        : orientation(orientation_), size(size_), origin(origin_) {}
+    constexpr Layout(const Orientation& orientation_, Point size_, Point origin_)
+        : orientation(orientation_), size(size_), origin(origin_),
+          cornerOffsets(ScaleCorners(orientation_.corners, size_)) {}
 };
 
 // ============================================================================
 // Pixel to hex and hex to pixel conversion
 // ============================================================================
-inline Point HexToPixel(Layout layout, Hex h) {
+inline Point HexToPixel(const Layout& layout, Hex h) {
     const Orientation& M = layout.orientation;
     double x = (M.f0 * h.q + M.f1 * h.r) * layout.size.x;
     double y = (M.f2 * h.q + M.f3 * h.r) * layout.size.y;
     return Point(x + layout.origin.x, y + layout.origin.y);
 }
 
-inline FractionalHex PixelToHex(Layout layout, Point p) {
+inline FractionalHex PixelToHex(const Layout& layout, Point p) {
     const Orientation& M = layout.orientation;
     Point pt = Point((p.x - layout.origin.x) / layout.size.x,
                      (p.y - layout.origin.y) / layout.size.y);
@@ -213,25 +238,29 @@ inline Hex HexRound(FractionalHex h) {
 // ============================================================================
 // Hex corner offset (for drawing)
 // ============================================================================
-inline Point HexCornerOffset(Layout layout, int corner) {
-    const Orientation& M = layout.orientation;
-    double angle = 2.0 * M_PI * (M.startAngle + corner) / 6.0;
-    return Point(layout.size.x * cos(angle), layout.size.y * sin(angle));
+inline Point HexCornerOffset(const Layout& layout, int corner) {
+    return layout.cornerOffsets[corner];
 }
 
-// Get all 6 corners of a hexagon
-inline std::vector<Point> PolygonCorners(Layout layout, Hex h) {
-    std::vector<Point> corners;
+// Get all 6 corners of a hexagon without allocating
+inline CornerTable HexCorners(const Layout& layout, Hex h) {
+    CornerTable corners;
     Point center = HexToPixel(layout, h);
 
     for (int i = 0; i < 6; i++) {
-        Point offset = HexCornerOffset(layout, i);
-        corners.push_back(Point(center.x + offset.x, center.y + offset.y));
+        corners[i] = Point(center.x + layout.cornerOffsets[i].x,
+                           center.y + layout.cornerOffsets[i].y);
     }
 
     return corners;
 }
 
+// Get all 6 corners of a hexagon
+inline std::vector<Point> PolygonCorners(const Layout& layout, Hex h) {
+    CornerTable corners = HexCorners(layout, h);
+    return std::vector<Point>(corners.begin(), corners.end());
+}
+
 // ============================================================================
 // Line drawing (interpolation between hexes)
 // ============================================================================
@@ -245,15 +274,28 @@ inline FractionalHex HexLerp(FractionalHex a, FractionalHex b, double t) {
                         Lerp(a.s, b.s, t));
 }
 
-inline std::vector<Hex> HexLinedraw(Hex a, Hex b) {
+// Calls fn(hex) for each hex on the line from a to b (both included)
+// without allocating. fn returns false to stop early.
+template <typename Fn>
+inline void HexLinedrawEach(Hex a, Hex b, Fn&& fn) {
     int N = HexDistance(a, b);
     FractionalHex aNudge = FractionalHex(a.q + 1e-6, a.r + 1e-6, a.s - 2e-6);
     FractionalHex bNudge = FractionalHex(b.q + 1e-6, b.r + 1e-6, b.s - 2e-6);
-    std::vector<Hex> results;
     double step = 1.0 / std::max(N, 1);
     for (int i = 0; i <= N; i++) {
-        results.push_back(HexRound(HexLerp(aNudge, bNudge, step * i)));
+        if (!fn(HexRound(HexLerp(aNudge, bNudge, step * i)))) {
+            return;
+        }
     }
+}
+
+inline std::vector<Hex> HexLinedraw(Hex a, Hex b) {
+    std::vector<Hex> results;
+    results.reserve(HexDistance(a, b) + 1);
+    HexLinedrawEach(a, b, [&](Hex h) {
+        results.push_back(h);
+        return true;
+    });
     return results;
 }
 
@@ -0,0 +1,132 @@
+#ifndef OPENWANZER_HEX_MAP_HPP
+#define OPENWANZER_HEX_MAP_HPP
+
+#include <cstdint>
+#include <vector>
+#include "Enums.hpp"
+#include "HexCoord.hpp"
+#include "HexTopology.hpp"
+#include "Visibility.hpp"
+
+// Per-hex map data stored as one contiguous array per field, indexed by
+// flat index (row * cols + col). Hot loops sweep a single field linearly
+// instead of striding through per-hex structs.
+class HexMap {
+public:
+	HexMap();
+
+	// Resize to rows x cols and reset every field (plains, neutral, nothing
+	// selected or spotted)
+	void resize(int rows, int cols);
+
+	int rows() const {
+		return rows_;
+	}
+	int cols() const {
+		return cols_;
+	}
+	int size() const {
+		return rows_ * cols_;
+	}
+
+	int index(int row, int col) const {
+		return row * cols_ + col;
+	}
+	int index(const HexCoord& coord) const {
+		return coord.row * cols_ + coord.col;
+	}
+	HexCoord coord(int index) const {
+		return HexCoord {index / cols_, index % cols_};
+	}
+	bool inBounds(int row, int col) const {
+		return row >= 0 && row < rows_ && col >= 0 && col < cols_;
+	}
+	bool inBounds(const HexCoord& coord) const {
+		return inBounds(coord.row, coord.col);
+	}
+
+	// Neighbor table, rebuilt by resize
+	const HexTopology& topology() const {
+		return topology_;
+	}
+
+	// Terrain (one byte per hex). Every change bumps terrainRevision() so
+	// cached per-map results (reachability, sight) can detect staleness.
+	TerrainType terrain(int index) const {
+		return static_cast<TerrainType>(terrain_[index]);
+	}
+	TerrainType terrain(const HexCoord& coord) const {
+		return terrain(index(coord));
+	}
+	void setTerrain(int index, TerrainType terrain) {
+		terrain_[index] = static_cast<uint8_t>(terrain);
+		terrainRevision_++;
+	}
+	const uint8_t* terrainData() const {
+		return terrain_.data();
+	}
+	unsigned int terrainRevision() const {
+		return terrainRevision_;
+	}
+
+	// Owner: -1 = neutral, 0 = axis, 1 = allied
+	int owner(int index) const {
+		return owner_[index];
+	}
+	void setOwner(int index, int side) {
+		owner_[index] = (int8_t)side;
+	}
+
+	bool isDeployment(int index) const {
+		return deployment_.test(index);
+	}
+	void setDeployment(int index, bool on) {
+		on ? deployment_.set(index) : deployment_.reset(index);
+	}
+
+	// Selection highlights (movement range / attack targets)
+	visibility::HexBitset& moveSel() {
+		return moveSel_;
+	}
+	const visibility::HexBitset& moveSel() const {
+		return moveSel_;
+	}
+	visibility::HexBitset& attackSel() {
+		return attackSel_;
+	}
+	const visibility::HexBitset& attackSel() const {
+		return attackSel_;
+	}
+	bool isMoveSel(const HexCoord& coord) const {
+		return moveSel_.test(index(coord));
+	}
+	bool isAttackSel(const HexCoord& coord) const {
+		return attackSel_.test(index(coord));
+	}
+	void clearSelection() {
+		moveSel_.clear();
+		attackSel_.clear();
+	}
+
+	// Fog-of-war plane per side
+	visibility::VisibilityLayer& spotting(int side) {
+		return spotting_[side];
+	}
+	const visibility::VisibilityLayer& spotting(int side) const {
+		return spotting_[side];
+	}
+
+private:
+	int rows_;
+	int cols_;
+	unsigned int terrainRevision_;
+	HexTopology topology_;
+	std::vector<uint8_t> terrain_;
+	std::vector<int8_t> owner_;
+	visibility::HexBitset deployment_;
+	visibility::HexBitset moveSel_;
+	visibility::HexBitset attackSel_;
+	visibility::VisibilityLayer spotting_[2];
+};
+
+#endif // OPENWANZER_HEX_MAP_HPP
@@ -0,0 +1,53 @@
+#ifndef OPENWANZER_HEX_TOPOLOGY_HPP
+#define OPENWANZER_HEX_TOPOLOGY_HPP
+
+#include <vector>
+
+// Neighbor deltas {dcol, drow} in HexNeighbor direction order
+// (E, NE, NW, W, SW, SE). Odd rows are shifted right.
+constexpr int kEvenRowNeighbors[6][2] = {{1, 0}, {0, -1}, {-1, -1}, {-1, 0}, {-1, 1}, {0, 1}};
+constexpr int kOddRowNeighbors[6][2] = {{1, 0}, {1, -1}, {0, -1}, {-1, 0}, {0, 1}, {1, 1}};
+
+// Adjacency of a rows x cols odd-r hex grid, built once per map. Every hex
+// has kDirections neighbor slots in HexNeighbor direction order holding a
+// flat index (row * cols + col), or -1 where the neighbor is off the map.
+class HexTopology {
+public:
+	static constexpr int kDirections = 6;
+
+	HexTopology();
+
+	void build(int rows, int cols);
+
+	int rows() const {
+		return rows_;
+	}
+	int cols() const {
+		return cols_;
+	}
+	int size() const {
+		return rows_ * cols_;
+	}
+
+	// The kDirections neighbor slots of index (may contain -1)
+	const int* neighbors(int index) const {
+		return &table_[index * kDirections];
+	}
+
+	// Calls fn(neighborIndex, direction) for each on-map neighbor
+	template <typename Fn>
+	void forEachNeighbor(int index, Fn&& fn) const {
+		const int* slots = neighbors(index);
+		for (int dir = 0; dir < kDirections; dir++) {
+			if (slots[dir] >= 0)
+				fn(slots[dir], dir);
+		}
+	}
+
+private:
+	int rows_;
+	int cols_;
+	std::vector<int> table_;
+};
+
+#endif // OPENWANZER_HEX_TOPOLOGY_HPP
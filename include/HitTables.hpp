@@ -3,11 +3,22 @@
 
 #include "ArmorLocation.hpp"
 #include "CombatArcs.hpp"
+#include "Random.hpp"
 
 namespace hittables {
 
+constexpr int kMissPercent = 30;      // Chance a shot misses outright
+constexpr int kCenterHitPercent = 10; // Chance a hit lands on CENTER whatever the arc
+
+// Location a hit from arc strikes when it is not a CENTER hit
+ArmorLocation arcLocation(combatarcs::AttackArc arc);
+
 // Roll hit location based on attack arc
-ArmorLocation rollHitLocation(combatarcs::AttackArc arc);
+ArmorLocation rollHitLocation(combatarcs::AttackArc arc, rng::Pcg32& rng);
+
+// Miss roll on the COMBAT stream, then the hit location on HIT_TABLE.
+// False on a miss.
+bool rollAttack(combatarcs::AttackArc arc, rng::RandomService& random, ArmorLocation& location);
 
 } // namespace hittables
 
@@ -0,0 +1,77 @@
+#ifndef OPENWANZER_LINE_OF_SIGHT_HPP
+#define OPENWANZER_LINE_OF_SIGHT_HPP
+
+#include <cstdint>
+#include <vector>
+#include "Enums.hpp"
+#include "HexCoord.hpp"
+
+namespace los {
+
+// Terrain opacity, summed over the hexes strictly between viewer and target.
+// Sight is blocked once the sum reaches kOpaque, so a single forest only
+// degrades sight while two forests (or any mountain/city) block it.
+constexpr int kClear = 0;
+constexpr int kObscuring = 1;
+constexpr int kOpaque = 2;
+
+int terrainOpacity(TerrainType terrain);
+
+// Line of sight over a rows x cols odd-r map (flat index row * cols + col).
+//
+// The per-unit field is a ring-by-ring sweep over a stencil that stores, for
+// every cube offset within range, the intermediate hexes of its HexLinedraw
+// line. The stencil is built once (and grown when a larger range is asked
+// for), so a sweep is just opacity lookups with an early out per ray, and
+// agrees exactly with the point-to-point hasLineOfSight test.
+class SightEngine {
+public:
+	SightEngine();
+
+	// Size the opacity plane (clears it)
+	void resize(int rows, int cols);
+	void setOpacity(int index, int opacity) {
+		opacity_[index] = (uint8_t)opacity;
+	}
+
+	// Flat indices of every hex visible from origin within range, sorted
+	// ascending. The origin itself is always included.
+	void computeVisible(const HexCoord& origin, int range, std::vector<int>& out);
+
+	// Point-to-point test (no allocation, any distance)
+	bool hasLineOfSight(const HexCoord& from, const HexCoord& to) const;
+
+	unsigned int terrainRevision; // GameState::terrainRevision the plane was built from
+
+private:
+	struct Ray {
+		int dq, dr;    // Target offset from the viewer (cube)
+		int stepBegin; // Intermediate hexes in steps_[stepBegin, stepEnd)
+		int stepEnd;
+	};
+	struct Step {
+		int dq, dr;
+	};
+
+	int rows_;
+	int cols_;
+	std::vector<uint8_t> opacity_;
+	int stencilRange_;
+	std::vector<Ray> rays_;        // Ring order: ring 1 first
+	std::vector<int> ringEnd_;     // rays_ index one past the end of ring k
+	std::vector<Step> steps_;
+
+	void growStencil(int range);
+
+	// Opacity at a cube coordinate, off-map hexes are clear
+	int opacityAt(int q, int r) const {
+		int col = q + (r - (r & 1)) / 2;
+		if (r < 0 || r >= rows_ || col < 0 || col >= cols_)
+			return kClear;
+		return opacity_[r * cols_ + col];
+	}
+};
+
+} // namespace los
+
+#endif // OPENWANZER_LINE_OF_SIGHT_HPP
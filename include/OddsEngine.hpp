@@ -0,0 +1,76 @@
+#ifndef OPENWANZER_ODDS_ENGINE_HPP
+#define OPENWANZER_ODDS_ENGINE_HPP
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+#include "ArmorLocation.hpp"
+#include "CombatArcs.hpp"
+#include "Random.hpp"
+#include "Unit.hpp"
+
+namespace odds {
+
+// Outcome distribution of a volley against one target
+struct AttackOdds {
+	double hitChance;      // At least one shot hits
+	double killChance;     // CENTER destroyed by the end of the volley
+	double expectedDamage; // Armor and structure removed
+	double destroyChance[kArmorLocationCount]; // Location destroyed by the end, indexed by ArmorLocation
+	bool exact;  // Enumerated; otherwise estimated from samples
+	int samples; // Monte Carlo samples drawn (0 when exact)
+
+	AttackOdds();
+};
+
+constexpr int kMaxExactShots = 8; // 3^8 = 6561 outcome sequences
+constexpr int kMonteCarloSamples = 4096;
+
+// Odds of shots (damage per shot, in firing order) all striking target from
+// arc. Each shot misses, hits CENTER or hits the arc's location, with the
+// hittables percentages, and is applied with damagesystem::applyDamage;
+// shots after a kill are lost. Volleys of up to kMaxExactShots are
+// enumerated exactly, longer ones are sampled from rng.
+AttackOdds computeOdds(const ArmorLocations& target, combatarcs::AttackArc arc, const std::vector<int>& shots,
+                       rng::Pcg32& rng);
+
+// Single-attack odds per (attacker, target, arc). An entry stays valid while
+// the target's armor and the attacker's damage are unchanged, so re-running
+// updateAttackLines during a facing preview costs one lookup per line.
+class OddsCache {
+public:
+	const AttackOdds& get(const Unit& attacker, const Unit& target, combatarcs::AttackArc arc);
+
+	void clear() {
+		entries_.clear();
+	}
+	size_t size() const {
+		return entries_.size();
+	}
+
+private:
+	struct Key {
+		UnitHandle attacker;
+		UnitHandle target;
+		combatarcs::AttackArc arc;
+
+		bool operator==(const Key& other) const {
+			return attacker == other.attacker && target == other.target && arc == other.arc;
+		}
+	};
+	struct KeyHash {
+		size_t operator()(const Key& key) const;
+	};
+	struct Entry {
+		ArmorLocations target; // Target state the odds were computed for
+		int damage;
+		AttackOdds odds;
+	};
+
+	std::unordered_map<Key, Entry, KeyHash> entries_;
+	rng::Pcg32 sampler_;
+};
+
+} // namespace odds
+
+#endif // OPENWANZER_ODDS_ENGINE_HPP
@@ -18,6 +18,8 @@ void handlePaperdollTooltips(GameState& game);
 
 // Flash overlay for hit animation
 void triggerHitFlash(GameState& game, Unit* unit, ArmorLocation location);
+// Combat event subscriber that flashes every location taking damage
+void flashCombatEvent(GameState& game, const combatevents::CombatEvent& event);
 void updatePanelFlashes(GameState& game);
 
 } // namespace paperdollui
@@ -0,0 +1,185 @@
+#ifndef OPENWANZER_PATH_ENGINE_HPP
+#define OPENWANZER_PATH_ENGINE_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <vector>
+#include "HexCoord.hpp"
+#include "HexTopology.hpp"
+
+namespace pathengine {
+
+// Movement table sentinels (see kMovTableDry)
+constexpr int kStopMoveCost = 254; // Can enter, but movement ends there
+constexpr int kNoEntryCost = 255;  // Impassable
+
+// Heap-based Dijkstra / A* over flat hex indices (row * cols + col).
+// Scratch arrays are sized once per map and reused across searches. A
+// generation stamp marks which entries belong to the current search, so
+// nothing has to be cleared between queries.
+//
+// Movement rules match the movement range flood fill and moveUnit: the
+// start hex is always expanded, other hexes only while budget is left; a
+// normal step adds its table cost and a stop-move step (254) uses up
+// whatever budget remains.
+class PathEngine {
+public:
+	PathEngine();
+
+	// Search over topology's grid, sizing scratch buffers to match (no-op
+	// if the grid size is unchanged). topology must outlive the engine's
+	// searches.
+	void setTopology(const HexTopology& topology);
+
+	// A* from start to goal. enterCost(from, to) returns the table cost of
+	// stepping between two adjacent flat indices. Returns true if goal was
+	// reached within budget.
+	template <typename EnterCostFn>
+	bool findPath(int start, int goal, int budget, EnterCostFn&& enterCost) {
+		run(start, goal, budget, enterCost);
+		return reached(goal);
+	}
+
+	// Dijkstra flood of every hex reachable from start within budget
+	template <typename EnterCostFn>
+	void flood(int start, int budget, EnterCostFn&& enterCost) {
+		run(start, -1, budget, enterCost);
+	}
+
+	// Results of the last search
+	bool reached(int index) const {
+		return generation_ != 0 && index >= 0 && index < (int)closed_.size() && closed_[index] == generation_;
+	}
+	int costTo(int index) const {
+		return reached(index) ? cost_[index] : -1;
+	}
+	int parentOf(int index) const {
+		return reached(index) ? parent_[index] : -1;
+	}
+	const std::vector<int>& settled() const {
+		return settled_;
+	}
+
+	// Writes the start..goal path of the last search into out (empty if
+	// goal was not reached)
+	void pathTo(int goal, std::vector<HexCoord>& out) const;
+	std::vector<HexCoord> pathTo(int goal) const;
+
+	int index(const HexCoord& coord) const {
+		return coord.row * cols_ + coord.col;
+	}
+	HexCoord coord(int index) const {
+		return HexCoord {index / cols_, index % cols_};
+	}
+	bool inBounds(const HexCoord& coord) const {
+		return coord.row >= 0 && coord.row < rows_ && coord.col >= 0 && coord.col < cols_;
+	}
+	int rows() const {
+		return rows_;
+	}
+	int cols() const {
+		return cols_;
+	}
+
+private:
+	struct HeapNode {
+		int priority; // cost + heuristic
+		int cost;
+		int index;
+	};
+
+	// std heap helpers build a max-heap; invert so the lowest priority pops
+	// first, preferring deeper nodes on ties
+	struct HeapOrder {
+		bool operator()(const HeapNode& a, const HeapNode& b) const {
+			return a.priority > b.priority || (a.priority == b.priority && a.cost < b.cost);
+		}
+	};
+
+	const HexTopology* topology_;
+	int rows_;
+	int cols_;
+	uint32_t generation_;
+	std::vector<int> cost_;
+	std::vector<int> parent_;
+	std::vector<uint32_t> seen_;   // == generation_ once cost_/parent_ are valid
+	std::vector<uint32_t> closed_; // == generation_ once settled
+	std::vector<int> settled_;
+	std::vector<HeapNode> heap_;
+
+	void beginSearch();
+
+	// Hex distance between flat indices (odd-r offset layout)
+	int distance(int a, int b) const {
+		int rowA = a / cols_, colA = a % cols_;
+		int rowB = b / cols_, colB = b % cols_;
+		int qA = colA - (rowA - (rowA & 1)) / 2;
+		int qB = colB - (rowB - (rowB & 1)) / 2;
+		int dq = qA - qB, dr = rowA - rowB;
+		return (std::abs(dq) + std::abs(dr) + std::abs(dq + dr)) / 2;
+	}
+
+	template <typename EnterCostFn>
+	void run(int start, int goal, int budget, EnterCostFn& enterCost);
+};
+
+template <typename EnterCostFn>
+void PathEngine::run(int start, int goal, int budget, EnterCostFn& enterCost) {
+	beginSearch();
+	if (!topology_ || start < 0 || start >= rows_ * cols_)
+		return;
+
+	// Every step costs at least 1, so hex distance never overestimates
+	auto heuristic = [&](int index) { return goal >= 0 ? distance(index, goal) : 0; };
+
+	seen_[start] = generation_;
+	cost_[start] = 0;
+	parent_[start] = -1;
+	heap_.push_back({heuristic(start), 0, start});
+
+	while (!heap_.empty()) {
+		std::pop_heap(heap_.begin(), heap_.end(), HeapOrder());
+		HeapNode node = heap_.back();
+		heap_.pop_back();
+
+		int current = node.index;
+		if (closed_[current] == generation_ || node.cost != cost_[current])
+			continue; // Stale entry superseded by a cheaper one
+
+		closed_[current] = generation_;
+		settled_.push_back(current);
+
+		if (current == goal)
+			return;
+		if (node.cost >= budget && current != start)
+			continue; // No movement left to leave this hex
+
+		const int* neighbors = topology_->neighbors(current);
+		for (int dir = 0; dir < HexTopology::kDirections; dir++) {
+			int next = neighbors[dir];
+			if (next < 0 || closed_[next] == generation_)
+				continue;
+
+			int step = enterCost(current, next);
+			if (step >= kNoEntryCost)
+				continue;
+
+			int newCost = (step == kStopMoveCost) ? budget : node.cost + step;
+			if (newCost > budget)
+				continue;
+			if (seen_[next] == generation_ && cost_[next] <= newCost)
+				continue;
+
+			seen_[next] = generation_;
+			cost_[next] = newCost;
+			parent_[next] = current;
+			heap_.push_back({newCost + heuristic(next), newCost, next});
+			std::push_heap(heap_.begin(), heap_.end(), HeapOrder());
+		}
+	}
+}
+
+} // namespace pathengine
+
+#endif // OPENWANZER_PATH_ENGINE_HPP
@@ -0,0 +1,96 @@
+#ifndef OPENWANZER_RANDOM_HPP
+#define OPENWANZER_RANDOM_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace rng {
+
+// PCG32 (XSH RR): 64-bit state, 32-bit output. Generators with different
+// stream ids produce independent sequences from the same seed.
+class Pcg32 {
+public:
+	struct State {
+		uint64_t state;
+		uint64_t inc; // Odd; selects the stream
+	};
+
+	Pcg32();
+	Pcg32(uint64_t seed, uint64_t stream);
+
+	void seed(uint64_t seed, uint64_t stream);
+
+	uint32_t next();
+	// Uniform in [0, bound), without modulo bias
+	uint32_t below(uint32_t bound);
+	// Uniform in [0, 1)
+	float unit();
+
+	State state() const {
+		return state_;
+	}
+	void setState(const State& state) {
+		state_ = state;
+	}
+
+private:
+	State state_;
+};
+
+// What a stream is used for. Each purpose draws from its own generator, so
+// e.g. cosmetic effects never shift combat rolls.
+enum class Stream : uint8_t {
+	COMBAT,    // Miss rolls
+	HIT_TABLE, // Hit location rolls
+	COSMETIC,  // Combat text placement
+	MAP,       // Terrain generation
+	COUNT
+};
+
+constexpr uint64_t kDefaultSeed = 0x5eed0f0e2a7e5ULL;
+
+// A game's random streams, all derived from one seed. Saving and restoring
+// the streams replays a battle exactly.
+class RandomService {
+public:
+	struct Snapshot {
+		uint64_t seed;
+		Pcg32::State streams[static_cast<int>(Stream::COUNT)];
+	};
+
+	// Serialized snapshot size in bytes
+	static constexpr size_t kSerializedSize = 8 + 16 * static_cast<size_t>(Stream::COUNT);
+
+	explicit RandomService(uint64_t seed = kDefaultSeed);
+
+	// Restart every stream from a new seed
+	void reseed(uint64_t seed);
+	uint64_t seed() const {
+		return seed_;
+	}
+
+	Pcg32& stream(Stream purpose) {
+		return streams_[static_cast<int>(purpose)];
+	}
+
+	// A generator for a simulation worker, independent of the game streams
+	// and of every other worker
+	Pcg32 workerStream(uint32_t worker) const;
+
+	Snapshot snapshot() const;
+	void restore(const Snapshot& snapshot);
+
+	// Little-endian byte form of snapshot(), for replay files
+	void serialize(std::vector<uint8_t>& out) const;
+	// Returns false, leaving the streams untouched, if data is too short
+	bool deserialize(const uint8_t* data, size_t size);
+
+private:
+	uint64_t seed_;
+	Pcg32 streams_[static_cast<int>(Stream::COUNT)];
+};
+
+} // namespace rng
+
+#endif // OPENWANZER_RANDOM_HPP
@@ -12,6 +12,26 @@ namespace rendering {
 // ============================================================================
 
 Layout createHexLayout(float hexSize, float offsetX, float offsetY, float zoom);
+
+// Inclusive block of map rows/cols that can be on screen, clamped to the map
+// (empty when rowMin > rowMax or colMin > colMax)
+struct HexRect {
+	int rowMin, rowMax;
+	int colMin, colMax;
+
+	bool empty() const {
+		return rowMin > rowMax || colMin > colMax;
+	}
+	bool contains(const HexCoord& coord) const {
+		return coord.row >= rowMin && coord.row <= rowMax && coord.col >= colMin && coord.col <= colMax;
+	}
+};
+
+// Hexes under viewport for a layout / at the current camera offset and zoom
+HexRect getHexRectInView(const HexMap& map, const Layout& layout, Rectangle viewport);
+HexRect getVisibleHexRect(const GameState& game, Rectangle viewport);
+// Hexes under the whole window (the map is drawn beneath every panel)
+HexRect getVisibleHexRect(const GameState& game);
 OffsetCoord gameCoordToOffset(const HexCoord& coord);
 HexCoord offsetToGameCoord(const OffsetCoord& offset);
 
@@ -19,11 +39,21 @@ HexCoord offsetToGameCoord(const OffsetCoord& offset);
 // HEX GEOMETRY & MAP RENDERING (hex_drawing.cpp)
 // ============================================================================
 
-void drawHexagon(const std::vector<Point>& corners, Color color, bool filled);
+void drawHexagon(const CornerTable& corners, Color color, bool filled);
 Color getTerrainColor(TerrainType terrain);
 Color getUnitColor(int side);
 std::string getUnitSymbol(UnitClass unitClass);
 
+// Terrain fills and grid lines as one batched mesh (rebuilt only when the
+// terrain revision or HEX_SIZE changed), drawn with the given placement
+void drawTerrainMesh(GameState& game, const HexRect& visible, float offsetX, float offsetY, float zoom);
+
+// Terrain texture cache: update renders missing on-screen tiles and must run
+// outside BeginDrawing/EndDrawing; drawTerrainLayer blits them (or falls
+// back to the mesh if the cache is not ready)
+void updateTerrainCache(GameState& game);
+void drawTerrainLayer(GameState& game, const HexRect& visible);
+void unloadTerrainCache(GameState& game);
 void drawMap(GameState& game);
 void clearSelectionHighlights(GameState& game);
 
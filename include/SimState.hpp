@@ -0,0 +1,126 @@
+#ifndef OPENWANZER_SIM_STATE_HPP
+#define OPENWANZER_SIM_STATE_HPP
+
+#include <cstddef>
+#include <vector>
+#include "GameState.hpp"
+#include "HexCoord.hpp"
+#include "LineOfSight.hpp"
+#include "Random.hpp"
+#include "Unit.hpp"
+#include "Visibility.hpp"
+
+namespace sim {
+
+// The rules-relevant part of a battle and nothing else: units, occupancy,
+// spotting, turn and RNG state (no UI, log, camera or loadouts). Every
+// change goes through an undo journal, so a checkpoint is a handful of
+// counters and rolling back costs only what changed since it was taken.
+// Copy one per search worker, then branch in place: checkpoint, play a
+// line, roll back.
+class SimState {
+public:
+	// Journal lengths plus the small fixed-size state at one moment
+	struct Checkpoint {
+		size_t units;
+		size_t occupancy;
+		size_t spotting;
+		rng::RandomService::Snapshot random;
+		int currentTurn;
+		int currentPlayer;
+	};
+
+	// Copy the rules data of game. Spotting is rebuilt from unit positions,
+	// so a tentative (unconfirmed) move counts as made.
+	explicit SimState(GameState& game);
+
+	int unitCount() const {
+		return (int)units_.size();
+	}
+	const Unit& unit(int index) const {
+		return units_[index];
+	}
+	int find(UnitHandle handle) const; // -1 if the unit isn't in this state
+	int unitAt(const HexCoord& coord) const {
+		return occupancy_[index(coord)];
+	}
+	bool isSpotted(int side, const HexCoord& coord) const {
+		return spotting_[side].isVisible(index(coord));
+	}
+	bool hasLineOfSight(const HexCoord& from, const HexCoord& to) const {
+		return sight_.hasLineOfSight(from, to);
+	}
+	int currentTurn() const {
+		return currentTurn_;
+	}
+	int currentPlayer() const {
+		return currentPlayer_;
+	}
+
+	// The gamelogic rules (gamelogic::enterCost, hittables::rollAttack and
+	// damagesystem::applyDamage) without events or log. moveUnit trusts the
+	// caller for the path, like gamelogic::moveUnit, and returns false if the
+	// move isn't allowed.
+	bool moveUnit(int unit, const HexCoord& target);
+	void setFacing(int unit, float facing);
+	int attack(int attacker, int target); // Damage dealt
+	void endTurn();
+
+	// Restart the RNG streams, so a search samples its own rolls rather than
+	// the game's next ones. Not journaled: rollback restores the checkpoint's.
+	void reseed(uint64_t seed) {
+		random_.reseed(seed);
+	}
+
+	Checkpoint checkpoint() const;
+	void rollback(const Checkpoint& checkpoint);
+	// Drop the journal; earlier checkpoints can no longer be rolled back to
+	void commit();
+	size_t journalSize() const {
+		return unitLog_.size() + occupancyLog_.size() + spotLog_.size();
+	}
+
+private:
+	// One journal per kind of data: the kinds never overlap, so each can be
+	// unwound on its own
+	struct UnitChange {
+		int unit;
+		Unit before;
+	};
+	struct OccupancyChange {
+		int index;
+		int before;
+	};
+	struct SpotChange {
+		int side;
+		int index;
+		bool added;
+	};
+
+	int rows_;
+	int cols_;
+	std::vector<Unit> units_;
+	std::vector<int> occupancy_; // Unit index per hex, -1 if empty
+	std::vector<uint8_t> terrain_; // gamelogic::getTerrainIndex per hex
+	visibility::VisibilityLayer spotting_[2];
+	los::SightEngine sight_;
+	rng::RandomService random_;
+	int currentTurn_;
+	int currentPlayer_;
+
+	std::vector<UnitChange> unitLog_;
+	std::vector<OccupancyChange> occupancyLog_;
+	std::vector<SpotChange> spotLog_;
+	std::vector<int> visible_; // computeVisible scratch
+
+	int index(const HexCoord& coord) const {
+		return coord.row * cols_ + coord.col;
+	}
+	Unit& edit(int unit); // Journals the unit and returns it for writing
+	void setOccupant(int index, int unit);
+	void setSpotting(int unit, bool on); // Add or remove its contribution at its position
+};
+
+} // namespace sim
+
+#endif // OPENWANZER_SIM_STATE_HPP
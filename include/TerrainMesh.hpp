@@ -0,0 +1,99 @@
+#ifndef OPENWANZER_TERRAIN_MESH_HPP
+#define OPENWANZER_TERRAIN_MESH_HPP
+
+#include <cstdint>
+#include <vector>
+#include "HexMap.hpp"
+
+struct MeshColor {
+	uint8_t r, g, b, a;
+};
+
+struct MeshVertex {
+	float x, y;
+	MeshColor color;
+};
+
+// Triangle list for the whole map's terrain fills and grid lines, built on
+// the CPU with no graphics dependency. Positions are in map space: zoom 1
+// with the map origin at (0, 0), so the renderer applies the camera offset
+// and zoom as a transform. Every triangle is wound the way raylib expects
+// (counter-clockwise on screen).
+//
+// Fills come first: kFillIndicesPerHex indices per hex in row-major order,
+// so hex i's fill is indices [fillBegin(i), fillBegin(i + 1)). Grid lines
+// follow: one quad per unique hex edge (shared edges once, owned by the
+// lower-index hex), also grouped per hex in row-major order, so hex i's
+// edges are [gridBegin(i), gridBegin(i + 1)). A run of hexes within one row
+// is therefore one contiguous fill range and one contiguous grid range.
+class TerrainMesh {
+public:
+	static constexpr int kFillVerticesPerHex = 7;  // Center + 6 corners
+	static constexpr int kFillIndicesPerHex = 18;  // 6 triangles
+	static constexpr int kEdgeVertices = 4;
+	static constexpr int kEdgeIndices = 6;
+
+	TerrainMesh();
+
+	// palette is indexed by TerrainType. gridWidth is the line thickness in
+	// map-space pixels.
+	void build(const HexMap& map, float hexSize, const MeshColor* palette, MeshColor gridColor, float gridWidth);
+
+	// True if the mesh was built from this terrain revision and hex size
+	bool matches(unsigned int terrainRevision, float hexSize) const {
+		return built_ && terrainRevision_ == terrainRevision && hexSize_ == hexSize;
+	}
+	void invalidate() {
+		built_ = false;
+	}
+
+	const std::vector<MeshVertex>& vertices() const {
+		return vertices_;
+	}
+	const std::vector<uint32_t>& indices() const {
+		return indices_;
+	}
+	int fillIndexCount() const {
+		return fillIndexCount_;
+	}
+	int gridEdgeCount() const {
+		return ((int)indices_.size() - fillIndexCount_) / kEdgeIndices;
+	}
+
+	// Map-space bounding box of every vertex
+	float minX() const {
+		return minX_;
+	}
+	float minY() const {
+		return minY_;
+	}
+	float maxX() const {
+		return maxX_;
+	}
+	float maxY() const {
+		return maxY_;
+	}
+
+	// Index ranges per hex (hex may be one past the last hex)
+	int fillBegin(int hex) const {
+		return hex * kFillIndicesPerHex;
+	}
+	int gridBegin(int hex) const {
+		return (int)gridStart_[hex];
+	}
+
+private:
+	std::vector<MeshVertex> vertices_;
+	std::vector<uint32_t> indices_;
+	std::vector<uint32_t> gridStart_; // First grid index per hex, plus end
+	int fillIndexCount_;
+	float minX_, minY_, maxX_, maxY_;
+	unsigned int terrainRevision_;
+	float hexSize_;
+	bool built_;
+
+	uint32_t addVertex(float x, float y, MeshColor color);
+	void addTriangle(uint32_t a, uint32_t b, uint32_t c);
+};
+
+#endif // OPENWANZER_TERRAIN_MESH_HPP
@@ -0,0 +1,67 @@
+#ifndef OPENWANZER_THREAD_POOL_HPP
+#define OPENWANZER_THREAD_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Work-stealing thread pool. Each worker has its own task deque: it pops
+// its newest task first and, when empty, steals the oldest task of another
+// worker. Tasks receive the index of the worker running them, so callers
+// can keep per-worker scratch state and merge it afterwards without locks.
+class ThreadPool {
+public:
+	using Task = std::function<void(int worker)>;
+
+	// threads <= 0 uses one worker per hardware thread
+	explicit ThreadPool(int threads = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	int size() const {
+		return (int)workers_.size();
+	}
+
+	// Queue a task. From a worker it goes on that worker's deque, otherwise
+	// the deques are filled round-robin.
+	void submit(Task task);
+
+	// Block until every submitted task has finished. Not for use from a
+	// worker thread.
+	void wait();
+
+	// Run fn(index, worker) for every index in [0, count) and wait. Indices
+	// are queued in chunks of grain (0 picks one from count and size()).
+	void parallelFor(int count, const std::function<void(int index, int worker)>& fn, int grain = 0);
+
+	// Index of the pool worker running the calling thread, or -1
+	static int currentWorker();
+
+private:
+	struct Queue {
+		std::mutex mutex;
+		std::deque<Task> tasks;
+	};
+
+	std::vector<std::thread> workers_;
+	std::vector<std::unique_ptr<Queue>> queues_;
+	std::atomic<int> queued_;  // Tasks waiting in any deque
+	std::atomic<int> pending_; // Tasks queued or running
+	std::atomic<unsigned> nextQueue_;
+	std::mutex sleepMutex_;
+	std::condition_variable wake_; // Work arrived or stopping
+	std::condition_variable idle_; // pending_ reached 0
+	bool stopping_;
+
+	void run(int index);
+	bool pop(int index, Task& task);
+};
+
+#endif // OPENWANZER_THREAD_POOL_HPP
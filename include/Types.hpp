@@ -3,12 +3,10 @@
 
 // Forward declarations for core types
 struct HexCoord;
-struct GameHex;
 struct Unit;
 struct CameraState;
 struct VideoSettings;
 struct GameLayout;
-struct LogMessage;
 struct CombatLog;
 struct UnitInfoBox;
 struct MovementSelection;
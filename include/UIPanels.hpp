@@ -15,6 +15,8 @@ void showTargetPanel(GameState& game, Unit* target, combatarcs::AttackArc arc);
 void showPlayerPanel(GameState& game, Unit* player);
 void hideTargetPanel(GameState& game);
 void hidePlayerPanel(GameState& game);
+// GameHooks::turnEnded handler: hides both panels
+void onTurnEnded(GameState& game);
 
 // Panel position management
 void resetPanelPositions(GameState& game);
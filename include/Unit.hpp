@@ -1,8 +1,8 @@
 #ifndef OPENWANZER_UNIT_HPP
 #define OPENWANZER_UNIT_HPP
 
+#include <cstdint>
 #include <string>
-#include <map>
 #include <vector>
 #include "HexCoord.hpp"
 #include "Enums.hpp"
@@ -26,16 +26,46 @@ struct Weapon {
         : name(n), type(t), damage(dmg), isDestroyed(false) {}
 };
 
+// Hexes a unit currently contributes to its side's visibility layer, and
+// what they were computed from (recomputed when any of these change)
+struct SightCache {
+  std::vector<int> hexes; // Sorted flat indices (row * MAP_COLS + col)
+  HexCoord origin;
+  int range;
+  unsigned int terrainRevision;
+  bool valid;
+
+  SightCache() : origin{-1, -1}, range(0), terrainRevision(0), valid(false) {}
+};
+
+// Names a unit slot in a UnitStore. generation 0 is the null handle; a
+// handle whose unit has been destroyed no longer resolves.
+struct UnitHandle {
+  uint32_t index;
+  uint32_t generation;
+
+  UnitHandle() : index(0), generation(0) {}
+  UnitHandle(uint32_t index_, uint32_t generation_) : index(index_), generation(generation_) {}
+
+  bool isNull() const { return generation == 0; }
+  bool operator==(const UnitHandle& other) const {
+    return index == other.index && generation == other.generation;
+  }
+  bool operator!=(const UnitHandle& other) const { return !(*this == other); }
+};
+
+// Per-unit state read by the game loop, movement, combat and rendering.
+// Kept free of heap-owning members so the records pack densely in the
+// UnitStore; rarely touched data lives in UnitDetails.
 struct Unit {
-  std::string name;
+  UnitHandle handle; // This unit's own slot
   UnitClass unitClass;
   int side;     // 0 = axis, 1 = allied
 
   // **NEW: Location-based damage**
   enum class WeightClass { LIGHT, MEDIUM, HEAVY, ASSAULT };
   WeightClass weightClass;
-  std::map<ArmorLocation, LocationStatus> locations;
-  std::vector<Weapon> weapons;
+  ArmorLocations locations;
 
   HexCoord position;
 
@@ -53,7 +83,6 @@ struct Unit {
 
   bool hasMoved;
   bool hasFired;
-  bool isCore; // campaign unit
 
   // Facing system (0-360 degrees, exact angle)
   float facing;
@@ -64,15 +93,30 @@ struct Unit {
         weaponRange(3),
         movMethod(MovMethod::TRACKED), movementPoints(6),
         movesLeft(6), spotRange(2),
-        hasMoved(false), hasFired(false), isCore(false), facing(0.0f) {
+        hasMoved(false), hasFired(false), facing(0.0f) {
     initializeLocations(WeightClass::MEDIUM);
   }
 
   void initializeLocations(WeightClass wClass);
-  void initializeWeapons();
   bool isAlive() const;
   bool canMove() const;
   int getOverallHealthPercent() const;
 };
 
+// Two cache lines, so a scan over the UnitStore touches at most two per unit
+static_assert(sizeof(Unit) <= 128, "Unit should fit in two cache lines");
+
+// Cold per-unit data, stored beside the Unit records (UnitStore::details)
+struct UnitDetails {
+  std::string name;
+  std::vector<Weapon> weapons;
+  bool isCore; // campaign unit
+
+  SightCache sight; // Line-of-sight spotting contribution
+
+  UnitDetails() : isCore(false) {}
+
+  void initializeWeapons(Unit::WeightClass weightClass);
+};
+
 #endif // OPENWANZER_UNIT_HPP
@@ -0,0 +1,110 @@
+#ifndef OPENWANZER_UNIT_STORE_HPP
+#define OPENWANZER_UNIT_STORE_HPP
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "Unit.hpp"
+
+// Slot map owning every unit. Unit records are allocated in fixed-size
+// chunks, so they sit contiguously for iteration and a unit's address never
+// changes while it is alive. Handles carry the slot's generation: destroying
+// a unit bumps it, so stale handles resolve to nullptr instead of whatever
+// reuses the slot. Cold data lives in a parallel UnitDetails array.
+class UnitStore {
+public:
+	static constexpr int kChunkSize = 32;
+
+	// Visits live units in slot order, yielding Unit*
+	template <typename UnitT, typename StoreT>
+	class Iterator {
+	public:
+		Iterator(StoreT* store, uint32_t index)
+		    : store_(store), index_(index) {
+			skipDead();
+		}
+
+		UnitT* operator*() const {
+			return &store_->slot(index_);
+		}
+		Iterator& operator++() {
+			index_++;
+			skipDead();
+			return *this;
+		}
+		bool operator!=(const Iterator& other) const {
+			return index_ != other.index_;
+		}
+
+	private:
+		StoreT* store_;
+		uint32_t index_;
+
+		void skipDead() {
+			while (index_ < store_->slotCount() && !store_->live_[index_])
+				index_++;
+		}
+	};
+
+	using iterator = Iterator<Unit, UnitStore>;
+	using const_iterator = Iterator<const Unit, const UnitStore>;
+
+	UnitStore();
+
+	// Default-constructs a unit in a free slot and returns its handle
+	UnitHandle create();
+	void destroy(UnitHandle handle);
+	void clear();
+
+	// nullptr for null or stale handles
+	Unit* get(UnitHandle handle);
+	const Unit* get(UnitHandle handle) const;
+
+	UnitDetails& details(const Unit& unit) {
+		return details_[unit.handle.index];
+	}
+	const UnitDetails& details(const Unit& unit) const {
+		return details_[unit.handle.index];
+	}
+
+	// Live units
+	int size() const {
+		return liveCount_;
+	}
+	bool empty() const {
+		return liveCount_ == 0;
+	}
+
+	iterator begin() {
+		return iterator(this, 0);
+	}
+	iterator end() {
+		return iterator(this, slotCount());
+	}
+	const_iterator begin() const {
+		return const_iterator(this, 0);
+	}
+	const_iterator end() const {
+		return const_iterator(this, slotCount());
+	}
+
+private:
+	std::vector<std::unique_ptr<Unit[]>> chunks_;
+	std::vector<UnitDetails> details_;
+	std::vector<uint32_t> generations_;
+	std::vector<uint8_t> live_;
+	std::vector<uint32_t> freeSlots_;
+	int liveCount_;
+
+	uint32_t slotCount() const {
+		return (uint32_t)generations_.size();
+	}
+	Unit& slot(uint32_t index) {
+		return chunks_[index / kChunkSize][index % kChunkSize];
+	}
+	const Unit& slot(uint32_t index) const {
+		return chunks_[index / kChunkSize][index % kChunkSize];
+	}
+};
+
+#endif // OPENWANZER_UNIT_STORE_HPP
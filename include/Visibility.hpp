@@ -0,0 +1,117 @@
+#ifndef OPENWANZER_VISIBILITY_HPP
+#define OPENWANZER_VISIBILITY_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace visibility {
+
+// One bit per hex over flat indices (row * MAP_COLS + col), 64 hexes per
+// word. Bulk operations are plain loops over the word arrays so the
+// compiler can vectorize them; bits past size() are always zero.
+class HexBitset {
+public:
+	HexBitset();
+
+	// Size for count hexes and clear every bit
+	void resize(int count);
+	void clear();
+
+	int size() const {
+		return size_;
+	}
+	bool test(int index) const {
+		return (words_[index >> 6] >> (index & 63)) & 1u;
+	}
+	void set(int index) {
+		words_[index >> 6] |= bit(index);
+	}
+	void reset(int index) {
+		words_[index >> 6] &= ~bit(index);
+	}
+
+	int count() const;
+	bool any() const;
+
+	// Calls fn(index) for every set bit in ascending index order
+	template <typename Fn>
+	void forEachSet(Fn&& fn) const {
+		for (size_t w = 0; w < words_.size(); w++) {
+			uint64_t word = words_[w];
+			while (word) {
+				fn((int)(w * 64) + __builtin_ctzll(word));
+				word &= word - 1;
+			}
+		}
+	}
+
+	// out = a & b, a | b, a & ~b. All operands must have the same size;
+	// out may alias either input.
+	static void intersect(const HexBitset& a, const HexBitset& b, HexBitset& out);
+	static void unite(const HexBitset& a, const HexBitset& b, HexBitset& out);
+	static void subtract(const HexBitset& a, const HexBitset& b, HexBitset& out);
+
+private:
+	int size_;
+	std::vector<uint64_t> words_;
+
+	static uint64_t bit(int index) {
+		return uint64_t(1) << (index & 63);
+	}
+};
+
+// Fog-of-war plane for one side. The bit is set while at least one spotter
+// covers the hex; the per-hex spotter count lives in a separate sidecar so
+// bulk queries only read the packed bits.
+class VisibilityLayer {
+public:
+	void resize(int count);
+
+	// Drop every spotter (full rebuild)
+	void clear();
+
+	// Add or remove one spotter. Returns true if the hex became visible
+	// (add) or hidden (remove).
+	bool addSpotter(int index) {
+		if (spotters_[index]++ != 0)
+			return false;
+		visible_.set(index);
+		return true;
+	}
+	bool removeSpotter(int index) {
+		if (spotters_[index] == 0 || --spotters_[index] != 0)
+			return false;
+		visible_.reset(index);
+		return true;
+	}
+
+	bool isVisible(int index) const {
+		return visible_.test(index);
+	}
+	int spotterCount(int index) const {
+		return spotters_[index];
+	}
+	const HexBitset& visible() const {
+		return visible_;
+	}
+
+	// Remember the current plane as the start-of-turn state
+	void markTurnStart() {
+		turnStart_ = visible_;
+	}
+
+	// Hexes visible now that were hidden at the last markTurnStart
+	void newlyVisible(HexBitset& out) const {
+		HexBitset::subtract(visible_, turnStart_, out);
+	}
+
+private:
+	HexBitset visible_;
+	HexBitset turnStart_;
+	std::vector<uint16_t> spotters_;
+};
+
+} // namespace visibility
+
+#endif // OPENWANZER_VISIBILITY_HPP
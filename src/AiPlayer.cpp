@@ -0,0 +1,448 @@
+#include "AiPlayer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include "CombatArcs.hpp"
+#include "GameLogic.hpp"
+#include "OddsEngine.hpp"
+
+namespace ai {
+
+TurnPlan::TurnPlan()
+    : side(0), candidatesTotal(0), candidatesEvaluated(0), elapsedMs(0.0) {
+}
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr int kArcCount = 4;
+constexpr double kKillWeight = 20.0;       // A likely kill outweighs a few points of damage
+constexpr double kThreatWeight = 0.5;      // Damage taken counts half as much as damage dealt
+constexpr double kMovingThreatWeight = 0.5; // Enemies that must move first to fire
+constexpr double kApproachWeight = 1.0;    // Per hex to the nearest enemy
+constexpr double kLossWeight = kKillWeight; // Losing the unit counts as much as a kill
+
+// Lookahead: the best static options are replayed on the SimState
+constexpr int kShortlistSize = 4;
+constexpr int kReplySamples = 16;               // Sampled return fire per option
+constexpr uint64_t kReplySeed = 0x7e91a5c3d2ULL; // Own rolls, not the game's next ones
+
+// Tried at every hex, along with straight at each enemy
+constexpr int kHexFacingCount = 6;
+const float kHexFacings[kHexFacingCount] = {0.0f, 60.0f, 120.0f, 180.0f, 240.0f, 300.0f};
+
+using ArcTable = std::array<double, kArcCount>;
+
+struct Candidate {
+	double score;
+	int hex;       // Index into the unit's candidate hexes
+	int facing;    // Index into the facing list
+	int target;    // Index into Snapshot::units, -1 to hold fire
+	bool valid;
+
+	Candidate()
+	    : score(0.0), hex(0), facing(0), target(-1), valid(false) {
+	}
+
+	// Ties go to the earlier option, so the pick doesn't depend on which
+	// worker found it
+	bool beats(const Candidate& other) const {
+		if (!other.valid)
+			return valid;
+		if (!valid || score != other.score)
+			return valid && score > other.score;
+		return hex != other.hex ? hex < other.hex : facing < other.facing;
+	}
+};
+
+// The best few options, best first
+struct Shortlist {
+	std::array<Candidate, kShortlistSize> options;
+
+	void offer(const Candidate& candidate) {
+		for (int i = 0; i < kShortlistSize; i++) {
+			if (candidate.beats(options[i])) {
+				std::move_backward(options.begin() + i, options.end() - 1, options.end());
+				options[i] = candidate;
+				return;
+			}
+		}
+	}
+};
+
+int nearestEnemyDistance(const std::vector<UnitView>& units, const std::vector<int>& enemies, const HexCoord& hex) {
+	int nearest = 0;
+	for (size_t i = 0; i < enemies.size(); i++) {
+		int distance = gamelogic::hexDistance(hex, units[enemies[i]].position);
+		if (i == 0 || distance < nearest)
+			nearest = distance;
+	}
+	return nearest;
+}
+
+// Plans one unit against the current (partly planned) positions
+class UnitSearch {
+public:
+	UnitSearch(const sim::SimState& state, const std::vector<UnitView>& units, int self)
+	    : state_(state), units_(units), self_(units[self]) {
+		for (int i = 0; i < (int)units.size(); i++) {
+			if (units[i].side != self_.side)
+				enemies_.push_back(i);
+			facings_.emplace_back(units[i].facing);
+		}
+		for (int f = 0; f < kHexFacingCount; f++) {
+			hexFacings_.emplace_back(kHexFacings[f]);
+		}
+
+		// One shot per attack, so every table entry is an exact enumeration
+		rng::Pcg32 unused;
+		offense_.resize(units.size());
+		threat_.resize(units.size());
+		for (int enemy : enemies_) {
+			const UnitView& other = units[enemy];
+			for (int arc = 0; arc < kArcCount; arc++) {
+				combatarcs::AttackArc attackArc = static_cast<combatarcs::AttackArc>(arc);
+				odds::AttackOdds dealt = odds::computeOdds(other.locations, attackArc, {self_.attack}, unused);
+				odds::AttackOdds taken = odds::computeOdds(self_.locations, attackArc, {other.attack}, unused);
+				offense_[enemy][arc] = kKillWeight * dealt.killChance + dealt.expectedDamage;
+				threat_[enemy][arc] = taken.expectedDamage;
+			}
+		}
+	}
+
+	const std::vector<int>& enemies() const {
+		return enemies_;
+	}
+	int facingCount() const {
+		return kHexFacingCount + (int)enemies_.size();
+	}
+
+	// Facing f at hex: a hex direction, or straight at an enemy
+	float facingAt(int f, const HexCoord& hex) const {
+		if (f < kHexFacingCount)
+			return kHexFacings[f];
+		return combatarcs::facingToward(hex, units_[enemies_[f - kHexFacingCount]].position);
+	}
+
+	// Best facing at hex, written into best if it beats it
+	void evaluate(const HexCoord& hex, int hexIndex, Candidate& best) const {
+		int approach = nearestEnemyDistance(units_, enemies_, hex);
+		for (int f = 0; f < facingCount(); f++) {
+			combatarcs::ArcFacing facing = f < kHexFacingCount ? hexFacings_[f] : combatarcs::ArcFacing(facingAt(f, hex));
+
+			Candidate option;
+			option.valid = true;
+			option.hex = hexIndex;
+			option.facing = f;
+
+			double offense = 0.0;
+			if (self_.canFire) {
+				for (int enemy : enemies_) {
+					const UnitView& other = units_[enemy];
+					if (gamelogic::hexDistance(hex, other.position) > self_.weaponRange)
+						continue;
+					if (!combatarcs::isInFiringArc(hex, facing, other.position))
+						continue;
+					if (!state_.hasLineOfSight(hex, other.position))
+						continue;
+					int arc = static_cast<int>(combatarcs::getAttackArc(hex, other.position, facings_[enemy]));
+					if (option.target < 0 || offense_[enemy][arc] > offense) {
+						offense = offense_[enemy][arc];
+						option.target = enemy;
+					}
+				}
+			}
+
+			double threat = 0.0;
+			for (int enemy : enemies_) {
+				const UnitView& other = units_[enemy];
+				int distance = gamelogic::hexDistance(other.position, hex);
+				if (distance > other.weaponRange + other.movementPoints)
+					continue;
+				bool inRange = distance <= other.weaponRange && state_.hasLineOfSight(other.position, hex);
+				int arc = static_cast<int>(combatarcs::getAttackArc(other.position, hex, facing));
+				threat += (inRange ? 1.0 : kMovingThreatWeight) * threat_[enemy][arc];
+			}
+
+			option.score = offense - kThreatWeight * threat - kApproachWeight * approach;
+			if (option.beats(best))
+				best = option;
+		}
+	}
+
+private:
+	const sim::SimState& state_;
+	const std::vector<UnitView>& units_;
+	const UnitView& self_;
+	std::vector<int> enemies_;
+	std::vector<combatarcs::ArcFacing> facings_;     // Per unit, prepared for arc tests
+	std::vector<combatarcs::ArcFacing> hexFacings_;  // kHexFacings, prepared
+	std::vector<ArcTable> offense_; // Per enemy and arc of it we hit
+	std::vector<ArcTable> threat_;  // Per enemy and arc of us it hits
+};
+
+// Chance unit self (a SimState index) is destroyed if it moves to hex, faces
+// facing and fires at target (-1 to hold fire), over sampled rolls of its
+// shot and the return fire of every enemy already in range and sight.
+// Enemies that must move first are left to the static threat term. state
+// is left as it was.
+double lossChance(sim::SimState& state, int self, const HexCoord& hex, float facing, int target) {
+	sim::SimState::Checkpoint before = state.checkpoint();
+	if (!(state.unit(self).position == hex) && !state.moveUnit(self, hex))
+		return 0.0;
+	state.setFacing(self, facing);
+	sim::SimState::Checkpoint placed = state.checkpoint();
+
+	int side = state.unit(self).side;
+	int losses = 0;
+	for (int sample = 0; sample < kReplySamples; sample++) {
+		// Every option sees the same rolls, so they differ only by position
+		state.reseed(kReplySeed + sample);
+		if (target >= 0)
+			state.attack(self, target);
+		state.endTurn();
+		for (int i = 0; i < state.unitCount() && state.unit(self).isAlive(); i++) {
+			const Unit& enemy = state.unit(i);
+			if (enemy.side == side || !enemy.isAlive())
+				continue;
+			if (gamelogic::hexDistance(enemy.position, hex) > enemy.weaponRange || !state.hasLineOfSight(enemy.position, hex))
+				continue;
+			state.attack(i, self);
+		}
+		if (!state.unit(self).isAlive())
+			losses++;
+		state.rollback(placed);
+	}
+
+	state.rollback(before);
+	return (double)losses / kReplySamples;
+}
+
+// Best target for unit in its current position and facing
+Unit* bestTarget(GameState& game, Unit* unit) {
+	combatarcs::ArcFacing facing(unit->facing);
+	Unit* best = nullptr;
+	const odds::AttackOdds* bestOdds = nullptr;
+
+	for (Unit* enemy : game.units) {
+		if (enemy->side == unit->side || !enemy->isAlive())
+			continue;
+		if (gamelogic::hexDistance(unit->position, enemy->position) > unit->weaponRange)
+			continue;
+		if (!combatarcs::isInFiringArc(unit->position, facing, enemy->position))
+			continue;
+		if (!gamelogic::hasLineOfSight(game, unit->position, enemy->position))
+			continue;
+
+		combatarcs::AttackArc arc = combatarcs::getAttackArc(unit->position, enemy->position, enemy->facing);
+		const odds::AttackOdds& enemyOdds = game.oddsCache.get(*unit, *enemy, arc);
+		if (!bestOdds || enemyOdds.killChance > bestOdds->killChance ||
+		    (enemyOdds.killChance == bestOdds->killChance && enemyOdds.expectedDamage > bestOdds->expectedDamage)) {
+			best = enemy;
+			bestOdds = &enemyOdds;
+		}
+	}
+	return best;
+}
+
+} // namespace
+
+Snapshot::Snapshot(GameState& game, int side)
+    : side(side), state(game) {
+}
+
+Snapshot takeSnapshot(GameState& game, int side) {
+	Snapshot snapshot(game, side);
+
+	for (Unit* unit : game.units) {
+		if (!unit->isAlive())
+			continue;
+
+		UnitView view;
+		view.handle = unit->handle;
+		view.side = unit->side;
+		view.position = unit->position;
+		view.facing = unit->facing;
+		view.locations = unit->locations;
+		view.attack = unit->attack;
+		view.weaponRange = unit->weaponRange;
+		view.movementPoints = unit->movementPoints;
+		view.canMove = !unit->hasMoved;
+		view.canFire = !unit->hasFired;
+
+		if (unit->side == side) {
+			view.reachable.push_back(unit->position);
+			if (view.canMove) {
+				const pathengine::PathEngine& search = gamelogic::getReachability(game, unit).search;
+				for (int index : search.settled()) {
+					HexCoord coord = search.coord(index);
+					if (!(coord == unit->position))
+						view.reachable.push_back(coord);
+				}
+			}
+		}
+		snapshot.units.push_back(std::move(view));
+	}
+	return snapshot;
+}
+
+TurnPlan planTurn(const Snapshot& snapshot, ThreadPool* pool, int budgetMs) {
+	Clock::time_point start = Clock::now();
+	TurnPlan plan;
+	plan.side = snapshot.side;
+
+	// Planned units move here, and in state, as their orders are made
+	std::vector<UnitView> units = snapshot.units;
+	sim::SimState state = snapshot.state;
+	std::vector<int> own;
+	std::vector<int> stateIndex; // Per unit, its index in state
+	for (int i = 0; i < (int)units.size(); i++) {
+		if (units[i].side == snapshot.side)
+			own.push_back(i);
+		stateIndex.push_back(state.find(units[i].handle));
+	}
+
+	for (size_t k = 0; k < own.size(); k++) {
+		UnitView& self = units[own[k]];
+		int selfState = stateIndex[own[k]];
+		UnitSearch search(state, units, own[k]);
+		if (search.enemies().empty())
+			break;
+
+		// Free hexes only (the flood ran before earlier units moved), closest
+		// to the enemy first so a cut-off search has seen the likely best
+		std::vector<HexCoord> hexes;
+		for (const HexCoord& hex : self.reachable) {
+			int occupant = state.unitAt(hex);
+			if (occupant < 0 || occupant == selfState)
+				hexes.push_back(hex);
+		}
+		std::stable_sort(hexes.begin() + 1, hexes.end(), [&](const HexCoord& a, const HexCoord& b) {
+			return nearestEnemyDistance(units, search.enemies(), a) < nearestEnemyDistance(units, search.enemies(), b);
+		});
+		plan.candidatesTotal += (int)hexes.size() * search.facingCount();
+
+		// Each unit gets an even share of the budget, plus whatever earlier
+		// units left unused
+		bool limited = budgetMs > 0;
+		Clock::time_point deadline = start + std::chrono::milliseconds((long long)budgetMs * (long long)(k + 1) / (long long)own.size());
+
+		std::atomic<int> evaluated(0);
+		std::vector<Shortlist> perWorker(pool ? pool->size() : 1);
+		auto evaluate = [&](int index, int worker) {
+			// The staying-put option is always scored
+			if (limited && index > 0 && Clock::now() >= deadline)
+				return;
+			Candidate atHex;
+			search.evaluate(hexes[index], index, atHex);
+			perWorker[worker].offer(atHex);
+			evaluated++;
+		};
+		if (pool) {
+			pool->parallelFor((int)hexes.size(), evaluate, 1);
+		} else {
+			for (int i = 0; i < (int)hexes.size(); i++) {
+				evaluate(i, 0);
+			}
+		}
+		plan.candidatesEvaluated += evaluated.load() * search.facingCount();
+
+		Shortlist shortlist;
+		for (const Shortlist& worker : perWorker) {
+			for (const Candidate& candidate : worker.options) {
+				shortlist.offer(candidate);
+			}
+		}
+
+		// Play each out on the state; ties keep the static order
+		Candidate best;
+		for (Candidate candidate : shortlist.options) {
+			if (!candidate.valid)
+				break;
+			const HexCoord& hex = hexes[candidate.hex];
+			int target = candidate.target >= 0 ? stateIndex[candidate.target] : -1;
+			candidate.score -= kLossWeight * lossChance(state, selfState, hex, search.facingAt(candidate.facing, hex), target);
+			if (!best.valid || candidate.score > best.score)
+				best = candidate;
+		}
+
+		UnitOrder order;
+		order.unit = self.handle;
+		order.moveTo = hexes[best.hex];
+		order.facing = search.facingAt(best.facing, order.moveTo);
+		order.target = best.target >= 0 ? units[best.target].handle : UnitHandle();
+		order.score = best.score;
+		plan.orders.push_back(order);
+
+		self.position = order.moveTo;
+		self.facing = order.facing;
+		if (!(state.unit(selfState).position == order.moveTo))
+			state.moveUnit(selfState, order.moveTo);
+		state.setFacing(selfState, order.facing);
+		state.commit();
+	}
+
+	plan.elapsedMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+	return plan;
+}
+
+void applyPlan(GameState& game, const TurnPlan& plan) {
+	for (const UnitOrder& order : plan.orders) {
+		Unit* unit = game.units.get(order.unit);
+		if (!unit || !unit->isAlive() || unit->side != plan.side)
+			continue;
+
+		if (!(order.moveTo == unit->position) && !unit->hasMoved && gamelogic::getReachability(game, unit).reaches(order.moveTo))
+			gamelogic::moveUnit(game, unit, order.moveTo);
+		unit->facing = order.facing;
+
+		if (order.target.isNull() || unit->hasFired)
+			continue;
+		Unit* target = game.units.get(order.target);
+		if (!target || !target->isAlive())
+			target = bestTarget(game, unit);
+		else if (gamelogic::hexDistance(unit->position, target->position) > unit->weaponRange ||
+		         !combatarcs::isInFiringArc(unit->position, unit->facing, target->position) ||
+		         !gamelogic::hasLineOfSight(game, unit->position, target->position))
+			target = nullptr;
+		if (target)
+			gamelogic::performAttack(game, unit, target);
+	}
+}
+
+void playAiTurn(GameState& game, int side) {
+	applyPlan(game, planTurn(takeSnapshot(game, side), nullptr, 0));
+}
+
+AiController::AiController(int threads)
+    : pool_(threads > 0 ? threads : std::max(1, (int)std::thread::hardware_concurrency() - 1)) {
+}
+
+AiController::~AiController() {
+	if (pending_.valid())
+		pending_.wait();
+}
+
+void AiController::begin(GameState& game, int side, int budgetMs) {
+	if (pending_.valid())
+		return;
+
+	// Shared with the search thread, which outlives this call
+	auto snapshot = std::make_shared<const Snapshot>(takeSnapshot(game, side));
+	pending_ = std::async(std::launch::async, [this, snapshot, budgetMs] {
+		return planTurn(*snapshot, &pool_, budgetMs);
+	});
+}
+
+bool AiController::poll(TurnPlan& plan) {
+	if (!pending_.valid() || pending_.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+		return false;
+	plan = pending_.get();
+	return true;
+}
+
+} // namespace ai
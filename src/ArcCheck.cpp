@@ -0,0 +1,143 @@
+//==============================================================================
+// arc-check - Compares the hex-space arc tests with the pixel/atan2 version
+//==============================================================================
+
+#include "CombatArcs.hpp"
+#include "Hex.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+using combatarcs::AttackArc;
+
+constexpr int kRadius = 12;
+constexpr double kTieTolerance = 1e-3; // Degrees from a boundary that count as a tie
+
+// The previous implementation: atan2 between pixel centers, in float
+float pixelRelativeAngle(Vector2 from, Vector2 to, float facing) {
+	float dx = to.x - from.x;
+	float dy = to.y - from.y;
+	float angle = atan2(dy, dx) * (180.0f / PI);
+	if (angle < 0)
+		angle += 360.0f;
+	float relative = angle - facing;
+	while (relative > 180.0f)
+		relative -= 360.0f;
+	while (relative < -180.0f)
+		relative += 360.0f;
+	return relative;
+}
+
+AttackArc pixelAttackArc(Vector2 attackerPos, Vector2 targetPos, float targetFacing) {
+	float relative = pixelRelativeAngle(targetPos, attackerPos, targetFacing);
+	if (fabs(relative) <= 30.0f)
+		return AttackArc::FRONT;
+	if (relative > 30.0f && relative <= 150.0f)
+		return AttackArc::RIGHT_SIDE;
+	if (relative < -30.0f && relative >= -150.0f)
+		return AttackArc::LEFT_SIDE;
+	return AttackArc::REAR;
+}
+
+bool pixelInFiringArc(Vector2 attackerPos, float attackerFacing, Vector2 targetPos) {
+	return fabs(pixelRelativeAngle(attackerPos, targetPos, attackerFacing)) <= 60.0f;
+}
+
+// Relative angle from the cube delta in double, to tell boundary ties apart
+double exactRelativeAngle(const HexCoord& from, const HexCoord& to, float facing) {
+	::Hex f = OffsetToCube(OffsetCoord(from.col, from.row));
+	::Hex t = OffsetToCube(OffsetCoord(to.col, to.row));
+	int dq = t.q - f.q;
+	int dr = t.r - f.r;
+	double angle = std::atan2(kSqrt3 * dr, 2.0 * dq + dr) * (180.0 / M_PI);
+	double relative = std::fmod(angle - facing, 360.0);
+	if (relative > 180.0)
+		relative -= 360.0;
+	if (relative < -180.0)
+		relative += 360.0;
+	return relative;
+}
+
+bool nearBoundary(double relative, double boundary) {
+	return std::fabs(std::fabs(relative) - boundary) < kTieTolerance;
+}
+
+Vector2 pixelCenter(const Layout& layout, const HexCoord& coord) {
+	Point p = HexToPixel(layout, OffsetToCube(OffsetCoord(coord.col, coord.row)));
+	return Vector2 {(float)p.x, (float)p.y};
+}
+
+// Every half degree, a spread of off-grid values and the normalization cases
+std::vector<float> sampleFacings() {
+	std::vector<float> facings;
+	for (int i = 0; i < 720; i++)
+		facings.push_back(i * 0.5f);
+	for (int i = 0; i < 2000; i++)
+		facings.push_back(std::fmod(i * 0.1793f + i * i * 0.0007f, 360.0f));
+	facings.push_back(360.0f);
+	facings.push_back(-30.0f);
+	facings.push_back(-0.0001f);
+	facings.push_back(1e-7f);
+	facings.push_back(720.5f);
+	return facings;
+}
+
+} // namespace
+
+int main() {
+	Layout layout(kLayoutPointy, Point(40, 40), Point(0, 0));
+	std::vector<float> facings = sampleFacings();
+
+	long pairs = 0, attackTies = 0, firingTies = 0, failures = 0;
+	// Even and odd origin rows place the offset neighbors differently
+	for (int originRow = 20; originRow <= 21; originRow++) {
+		HexCoord origin {originRow, 20};
+		Vector2 originPos = pixelCenter(layout, origin);
+		for (int dr = -kRadius; dr <= kRadius; dr++) {
+			for (int dc = -kRadius; dc <= kRadius; dc++) {
+				HexCoord other {originRow + dr, 20 + dc};
+				Vector2 otherPos = pixelCenter(layout, other);
+				for (float facing : facings) {
+					pairs++;
+					combatarcs::ArcFacing arcFacing(facing);
+
+					// other attacks origin
+					if (combatarcs::getAttackArc(other, origin, arcFacing) != pixelAttackArc(otherPos, originPos, facing)) {
+						double relative = exactRelativeAngle(origin, other, facing);
+						if (nearBoundary(relative, 30.0) || nearBoundary(relative, 150.0)) {
+							attackTies++;
+						} else if (failures++ < 10) {
+							printf("attack arc mismatch: origin (%d,%d) attacker (%d,%d) facing %g relative %g\n",
+							       origin.row, origin.col, other.row, other.col, facing, relative);
+						}
+					}
+
+					// origin fires at other
+					if (combatarcs::isInFiringArc(origin, arcFacing, other) != pixelInFiringArc(originPos, facing, otherPos)) {
+						double relative = exactRelativeAngle(origin, other, facing);
+						if (nearBoundary(relative, 60.0)) {
+							firingTies++;
+						} else if (failures++ < 10) {
+							printf("firing arc mismatch: origin (%d,%d) target (%d,%d) facing %g relative %g\n",
+							       origin.row, origin.col, other.row, other.col, facing, relative);
+						}
+					}
+
+					// The float overloads must agree with ArcFacing
+					if (combatarcs::getAttackArc(other, origin, facing) != combatarcs::getAttackArc(other, origin, arcFacing) ||
+					    combatarcs::isInFiringArc(origin, facing, other) != combatarcs::isInFiringArc(origin, arcFacing, other)) {
+						if (failures++ < 10)
+							printf("overload mismatch: facing %g\n", facing);
+					}
+				}
+			}
+		}
+	}
+
+	printf("%ld pairs x facings, %ld attack and %ld firing boundary ties, %ld mismatches\n", pairs, attackTies,
+	       firingTies, failures);
+	return failures == 0 ? 0 : 1;
+}
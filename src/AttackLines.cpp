@@ -1,70 +1,56 @@
 #include "CombatArcs.hpp"
-#include "Constants.hpp"
 #include "GameLogic.hpp"
-#include "Rendering.hpp"
 
 namespace gamelogic {
 
 void updateAttackLines(GameState& game) {
-	if (!game.selectedUnit)
+	if (!game.selectedUnit())
 		return;
 
 	game.attackLines.clear();
 
 	// Only show targeting lines for friendly units that haven't fired yet
-	if (game.selectedUnit->side != game.currentPlayer || game.selectedUnit->hasFired) {
+	if (game.selectedUnit()->side != game.currentPlayer || game.selectedUnit()->hasFired) {
 		return;
 	}
 
 	// If in facing selection mode, use preview facing
 	// Otherwise use confirmed facing
-	float facing = game.movementSel.isFacingSelection
-	                   ? game.movementSel.selectedFacing
-	                   : game.selectedUnit->facing;
-
-	Layout layout = rendering::createHexLayout(HEX_SIZE, 0, 0, 1.0f);
-
-	OffsetCoord attackerOffset = rendering::gameCoordToOffset(game.selectedUnit->position);
-	::Hex attackerCube = OffsetToCube(attackerOffset);
-	Point attackerPos = HexToPixel(layout, attackerCube);
-
-	for (const auto& unit : game.units) {
-		// Skip self, friendlies, and dead units
-		if (unit.get() == game.selectedUnit || unit->side == game.selectedUnit->side)
-			continue;
-		if (!unit->isAlive())
-			continue;
-
-		// Only show targeting lines to units that are in LOS (spotted by current player)
-		GameHex& targetHex = game.map[unit->position.row][unit->position.col];
-		if (!targetHex.isSpotted(game.currentPlayer))
-			continue;
-
-		OffsetCoord targetOffset = rendering::gameCoordToOffset(unit->position);
-		::Hex targetCube = OffsetToCube(targetOffset);
-		Point targetPos = HexToPixel(layout, targetCube);
-
-		Vector2 atkPos = {(float)attackerPos.x, (float)attackerPos.y};
-		Vector2 tgtPos = {(float)targetPos.x, (float)targetPos.y};
+	combatarcs::ArcFacing facing(game.movementSel.isFacingSelection
+	                                 ? game.movementSel.selectedFacing
+	                                 : game.selectedUnit()->facing);
+	HexCoord attackerPos = game.selectedUnit()->position;
+
+	// Only show targeting lines to living enemy units spotted by the current
+	// player that the attacker itself has line of sight to
+	visibility::HexBitset targets;
+	game.spottedEnemyHexes(game.currentPlayer, targets);
+
+	targets.forEachSet([&](int index) {
+		const Unit* unit = game.occupancy[index];
+		if (!unit || unit->side == game.selectedUnit()->side)
+			return;
+		if (!hasLineOfSight(game, game.selectedUnit()->position, unit->position))
+			return;
 
 		// Check if target is in firing arc
-		if (!combatarcs::isInFiringArc(atkPos, facing, tgtPos))
-			continue;
+		if (!combatarcs::isInFiringArc(attackerPos, facing, unit->position))
+			return;
 
 		// Calculate which arc of target we're hitting
-		combatarcs::AttackArc arc = combatarcs::getAttackArc(
-		    atkPos, tgtPos, unit->facing);
+		combatarcs::AttackArc arc = combatarcs::getAttackArc(attackerPos, unit->position, combatarcs::ArcFacing(unit->facing));
 
 		// Check if target is out of range
-		int distance = hexDistance(game.selectedUnit->position, unit->position);
-		bool outOfRange = distance > game.selectedUnit->weaponRange;
+		int distance = hexDistance(game.selectedUnit()->position, unit->position);
+		bool outOfRange = distance > game.selectedUnit()->weaponRange;
 
 		game.attackLines.emplace_back(
-		    game.selectedUnit->position,
+		    game.selectedUnit()->position,
 		    unit->position,
 		    arc,
-		    outOfRange);
-	}
+		    outOfRange,
+		    game.oddsCache.get(*game.selectedUnit(), *unit, arc));
+	});
 }
 
 } // namespace gamelogic
@@ -0,0 +1,222 @@
+#include "BattleSim.hpp"
+
+#include <algorithm>
+#include "CombatArcs.hpp"
+#include "Constants.hpp"
+#include "GameLogic.hpp"
+
+namespace battlesim {
+
+BattleResult::BattleResult()
+    : winner(-1), turns(0), unitsLeft {0, 0}, damageDealt {0, 0} {
+}
+
+namespace {
+
+// Start hexes, as in the interactive game's setup
+const HexCoord kAnchors[2] = {{2, 2}, {8, 10}};
+
+Unit* nearestEnemy(GameState& game, const Unit& unit) {
+	Unit* nearest = nullptr;
+	int nearestDistance = 0;
+	for (Unit* other : game.units) {
+		if (other->side == unit.side || !other->isAlive())
+			continue;
+		int distance = gamelogic::hexDistance(unit.position, other->position);
+		if (!nearest || distance < nearestDistance) {
+			nearest = other;
+			nearestDistance = distance;
+		}
+	}
+	return nearest;
+}
+
+// Move to the reachable hex closest to goal, cheapest first on ties
+void advance(GameState& game, Unit* unit, const HexCoord& goal) {
+	const ReachabilityField& field = gamelogic::getReachability(game, unit);
+	const pathengine::PathEngine& search = field.search;
+
+	int best = -1;
+	int bestDistance = gamelogic::hexDistance(unit->position, goal);
+	for (int index : search.settled()) {
+		int distance = gamelogic::hexDistance(search.coord(index), goal);
+		if (distance < bestDistance || (distance == bestDistance && best >= 0 && search.costTo(index) < search.costTo(best))) {
+			best = index;
+			bestDistance = distance;
+		}
+	}
+	if (best >= 0)
+		gamelogic::moveUnit(game, unit, search.coord(best));
+}
+
+// An enemy with its facing prepared for arc tests. Enemies don't turn
+// during our turn, so this is built once per turn.
+struct Enemy {
+	Unit* unit;
+	combatarcs::ArcFacing facing;
+};
+
+void fireBest(GameState& game, Unit* unit, const std::vector<Enemy>& enemies) {
+	combatarcs::ArcFacing facing(unit->facing);
+	Unit* best = nullptr;
+	const odds::AttackOdds* bestOdds = nullptr;
+
+	for (const Enemy& candidate : enemies) {
+		Unit* enemy = candidate.unit;
+		if (!enemy->isAlive())
+			continue;
+		if (gamelogic::hexDistance(unit->position, enemy->position) > unit->weaponRange)
+			continue;
+		if (!combatarcs::isInFiringArc(unit->position, facing, enemy->position))
+			continue;
+		if (!gamelogic::hasLineOfSight(game, unit->position, enemy->position))
+			continue;
+
+		combatarcs::AttackArc arc = combatarcs::getAttackArc(unit->position, enemy->position, candidate.facing);
+		const odds::AttackOdds& enemyOdds = game.oddsCache.get(*unit, *enemy, arc);
+		if (!bestOdds || enemyOdds.killChance > bestOdds->killChance ||
+		    (enemyOdds.killChance == bestOdds->killChance && enemyOdds.expectedDamage > bestOdds->expectedDamage)) {
+			best = enemy;
+			bestOdds = &enemyOdds;
+		}
+	}
+
+	if (best)
+		gamelogic::performAttack(game, unit, best);
+}
+
+// Place a unit on the free hex nearest the side's start hex that it can stand on
+void deploy(GameState& game, UnitClass unitClass, int side, const std::vector<HexCoord>& cells) {
+	Unit* unit = nullptr;
+	for (const HexCoord& cell : cells) {
+		if (game.getUnitAt(cell))
+			continue;
+		if (!unit) {
+			unit = game.units.get(game.addUnit(unitClass, side, cell.row, cell.col));
+		} else {
+			game.relocateUnit(unit, cell);
+		}
+
+		int movMethod = static_cast<int>(unit->movMethod);
+		if (kMovTableDry[movMethod][gamelogic::getTerrainIndex(game.map.terrain(cell))] < 254)
+			return;
+	}
+}
+
+// Per-attack damage and kills from this turn's combat events
+void collectAttacks(const GameState& game, BattleResult& result) {
+	using combatevents::CombatEventType;
+
+	int side = -1;
+	int damage = 0;
+	for (const combatevents::CombatEvent& event : game.combatEvents.events()) {
+		switch (event.type) {
+			case CombatEventType::ATTACK_DECLARED:
+				side = event.attacker->side;
+				damage = 0;
+				break;
+			case CombatEventType::ARMOR_ABSORBED:
+			case CombatEventType::STRUCTURE_DAMAGED:
+				damage += event.amount;
+				break;
+			case CombatEventType::MISS:
+			case CombatEventType::ATTACK_RESOLVED:
+				if (side >= 0) {
+					result.attackDamage[side].push_back(damage);
+					result.damageDealt[side] += damage;
+				}
+				side = -1;
+				break;
+			case CombatEventType::UNIT_DESTROYED:
+				result.killTurns[event.attacker->side].push_back(game.currentTurn);
+				break;
+			default:
+				break;
+		}
+	}
+}
+
+int livingUnits(GameState& game, int side) {
+	int count = 0;
+	for (Unit* unit : game.units) {
+		if (unit->side == side && unit->isAlive())
+			count++;
+	}
+	return count;
+}
+
+} // namespace
+
+void playScriptedTurn(GameState& game, int side) {
+	std::vector<Enemy> enemies;
+	for (Unit* unit : game.units) {
+		if (unit->side != side && unit->isAlive())
+			enemies.push_back({unit, combatarcs::ArcFacing(unit->facing)});
+	}
+
+	for (Unit* unit : game.units) {
+		if (unit->side != side || !unit->isAlive())
+			continue;
+
+		Unit* target = nearestEnemy(game, *unit);
+		if (!target)
+			return;
+
+		if (!unit->hasMoved && gamelogic::hexDistance(unit->position, target->position) > unit->weaponRange)
+			advance(game, unit, target->position);
+		unit->facing = combatarcs::facingToward(unit->position, target->position);
+
+		if (!unit->hasFired)
+			fireBest(game, unit, enemies);
+	}
+}
+
+BattleResult runBattle(const BattleSetup& setup, uint64_t seed) {
+	GameState game(seed);
+	BattleResult result;
+
+	for (int side = 0; side < 2; side++) {
+		// Every hex, nearest the start hex first
+		const HexCoord anchor = kAnchors[side];
+		std::vector<HexCoord> cells;
+		for (int index = 0; index < game.map.size(); index++) {
+			cells.push_back(game.map.coord(index));
+		}
+		std::stable_sort(cells.begin(), cells.end(), [&](const HexCoord& a, const HexCoord& b) {
+			return gamelogic::hexDistance(anchor, a) < gamelogic::hexDistance(anchor, b);
+		});
+
+		for (UnitClass unitClass : setup.units[side]) {
+			deploy(game, unitClass, side, cells);
+		}
+	}
+	gamelogic::initializeAllSpotting(game);
+
+	while (game.currentTurn <= setup.maxTurns) {
+		int side = game.currentPlayer;
+		setup.policy[side](game, side);
+		collectAttacks(game, result);
+
+		result.unitsLeft[0] = livingUnits(game, 0);
+		result.unitsLeft[1] = livingUnits(game, 1);
+		if (result.unitsLeft[0] == 0 || result.unitsLeft[1] == 0) {
+			result.winner = result.unitsLeft[0] > 0 ? 0 : (result.unitsLeft[1] > 0 ? 1 : -1);
+			result.turns = game.currentTurn;
+			return result;
+		}
+		gamelogic::endTurn(game);
+	}
+
+	result.turns = setup.maxTurns;
+	return result;
+}
+
+uint64_t battleSeed(uint64_t baseSeed, uint64_t battle) {
+	// SplitMix64 finalizer, so neighbouring battles get unrelated seeds
+	uint64_t z = baseSeed + (battle + 1) * 0x9e3779b97f4a7c15ULL;
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	return z ^ (z >> 31);
+}
+
+} // namespace battlesim
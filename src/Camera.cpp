@@ -169,7 +169,7 @@ void handleCombatLogDrag(GameState &game) {
 		}
 
 		// Unit info box dragging
-		if (game.selectedUnit && CheckCollisionPointRec(mousePos, game.unitInfoBox.bounds)) {
+		if (game.selectedUnit() && CheckCollisionPointRec(mousePos, game.unitInfoBox.bounds)) {
 			game.unitInfoBox.isDragging = true;
 			game.unitInfoBox.dragOffset.x = mousePos.x - game.unitInfoBox.bounds.x;
 			game.unitInfoBox.dragOffset.y = mousePos.y - game.unitInfoBox.bounds.y;
@@ -1,58 +1,166 @@
 #include "CombatArcs.hpp"
+#include "Hex.hpp"
+
+#include <algorithm>
 #include <cmath>
 
 namespace combatarcs {
 
-AttackArc getAttackArc(Vector2 attackerPos, Vector2 targetPos, float targetFacing) {
-	// Calculate angle from target to attacker
-	float dx = attackerPos.x - targetPos.x;
-	float dy = attackerPos.y - targetPos.y;
-	float attackerAngle = atan2(dy, dx) * (180.0f / PI);
+namespace {
+
+// Arc table entries: an AttackArc, or a sector an arc boundary passes through
+constexpr int kFront = static_cast<int>(AttackArc::FRONT);
+constexpr int kLeft = static_cast<int>(AttackArc::LEFT_SIDE);
+constexpr int kRight = static_cast<int>(AttackArc::RIGHT_SIDE);
+constexpr int kRear = static_cast<int>(AttackArc::REAR);
+constexpr int kStraddle = -1;
 
-	// Normalize to 0-360
-	if (attackerAngle < 0)
-		attackerAngle += 360.0f;
+// Tables are indexed by (sector - facing bucket) mod 12 = m. For a facing
+// strictly inside its bucket the relative angle lies in (30m - 30, 30m + 30).
+// For a facing on a multiple of 30 it is exactly 30m when the delta lies on
+// the sector's leading edge, and in (30m, 30m + 30) otherwise.
+constexpr int kAttackArcs[12] = {kFront, kStraddle, kRight, kRight, kRight, kStraddle,
+                                 kRear, kStraddle, kLeft, kLeft, kLeft, kStraddle};
+constexpr int kAttackArcsOnEdge[12] = {kFront, kFront, kRight, kRight, kRight, kRight,
+                                       kRear, kLeft, kLeft, kLeft, kLeft, kFront};
+constexpr int kAttackArcsInside[12] = {kFront, kRight, kRight, kRight, kRight, kRear,
+                                       kRear, kLeft, kLeft, kLeft, kLeft, kFront};
 
-	// Get relative angle to target's facing
-	float relativeAngle = attackerAngle - targetFacing;
+// 1 in the firing arc, 0 outside
+constexpr int kFiringArc[12] = {1, 1, kStraddle, 0, 0, 0, 0, 0, 0, 0, kStraddle, 1};
+constexpr int kFiringArcOnEdge[12] = {1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 1, 1};
+constexpr int kFiringArcInside[12] = {1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1};
 
-	// Normalize to -180 to +180
-	while (relativeAngle > 180.0f)
-		relativeAngle -= 360.0f;
-	while (relativeAngle < -180.0f)
-		relativeAngle += 360.0f;
+// Screen direction of the hex delta from -> to is proportional to
+// (a, sqrt(3) * b) with a = 2dq + dr and b = dr
+struct HexDelta {
+	int a, b;
+};
+
+HexDelta hexDelta(const HexCoord& from, const HexCoord& to) {
+	::Hex f = OffsetToCube(OffsetCoord(from.col, from.row));
+	::Hex t = OffsetToCube(OffsetCoord(to.col, to.row));
+	int dq = t.q - f.q;
+	int dr = t.r - f.r;
+	if (dq == 0 && dr == 0)
+		return {1, 0}; // Same hex: angle 0, as atan2(0, 0) gives
+	return {2 * dq + dr, dr};
+}
+
+// 30-degree sector [30k, 30k + 30) holding the delta's angle (y-down, east
+// is 0). onEdge is set when the angle is exactly 30k.
+int hexSector(HexDelta d, bool& onEdge) {
+	int half = 0;
+	if (d.b < 0 || (d.b == 0 && d.a < 0)) {
+		d.a = -d.a;
+		d.b = -d.b;
+		half = 6;
+	}
+
+	// Boundaries at 30, 60, 90, 120 and 150 degrees are a = 3b, b, 0, -b, -3b
+	int a = d.a, b = d.b;
+	int sector;
+	if (a > 3 * b) {
+		sector = 0;
+		onEdge = b == 0;
+	} else if (a > b) {
+		sector = 1;
+		onEdge = a == 3 * b;
+	} else if (a > 0) {
+		sector = 2;
+		onEdge = a == b;
+	} else if (a > -b) {
+		sector = 3;
+		onEdge = a == 0;
+	} else if (a > -3 * b) {
+		sector = 4;
+		onEdge = a == -b;
+	} else {
+		sector = 5;
+		onEdge = a == -3 * b;
+	}
+	return half + sector;
+}
+
+int tableLookup(HexDelta d, const ArcFacing& facing, const int* table, const int* onEdgeTable, const int* insideTable) {
+	bool onEdge = false;
+	int m = (hexSector(d, onEdge) - facing.bucket + 12) % 12;
+	if (!facing.aligned)
+		return table[m];
+	return onEdge ? onEdgeTable[m] : insideTable[m];
+}
+
+// Dot and cross product of the delta with the facing vector, for sectors a
+// boundary passes through. cos(relative) = dot / |d|.
+struct Projection {
+	double dot, cross, lengthSq;
+};
+
+Projection project(HexDelta d, const ArcFacing& facing) {
+	double dx = d.a;
+	double dy = kSqrt3 * d.b;
+	return {dx * facing.dirX + dy * facing.dirY, facing.dirX * dy - facing.dirY * dx, dx * dx + dy * dy};
+}
+
+} // namespace
+
+ArcFacing::ArcFacing(float facing) {
+	degrees = std::fmod(facing, 360.0f);
+	if (degrees < 0.0f)
+		degrees += 360.0f;
+	if (degrees >= 360.0f)
+		degrees = 0.0f;
+
+	bucket = std::min((int)(degrees / 30.0), 11);
+	aligned = (double)degrees == bucket * 30.0;
+
+	double radians = degrees * (PI / 180.0);
+	dirX = std::cos(radians);
+	dirY = std::sin(radians);
+}
+
+AttackArc getAttackArc(const HexCoord& attacker, const HexCoord& target, const ArcFacing& targetFacing) {
+	// Direction from target to attacker
+	HexDelta d = hexDelta(target, attacker);
+	int arc = tableLookup(d, targetFacing, kAttackArcs, kAttackArcsOnEdge, kAttackArcsInside);
+	if (arc != kStraddle)
+		return static_cast<AttackArc>(arc);
 
 	// BattleTech arcs: Front ±30°, Sides 30-150°, Rear ±150-180°
-	if (fabs(relativeAngle) <= 30.0f)
+	Projection p = project(d, targetFacing);
+	if (p.dot >= 0.0 && p.dot * p.dot >= 0.75 * p.lengthSq)
 		return AttackArc::FRONT;
-	if (relativeAngle > 30.0f && relativeAngle <= 150.0f)
-		return AttackArc::RIGHT_SIDE;
-	if (relativeAngle < -30.0f && relativeAngle >= -150.0f)
-		return AttackArc::LEFT_SIDE;
-	return AttackArc::REAR;
+	if (p.dot < 0.0 && p.dot * p.dot > 0.75 * p.lengthSq)
+		return AttackArc::REAR;
+	return p.cross > 0.0 ? AttackArc::RIGHT_SIDE : AttackArc::LEFT_SIDE;
 }
 
-bool isInFiringArc(Vector2 attackerPos, float attackerFacing, Vector2 targetPos) {
-	// Calculate angle from attacker to target
-	float dx = targetPos.x - attackerPos.x;
-	float dy = targetPos.y - attackerPos.y;
-	float targetAngle = atan2(dy, dx) * (180.0f / PI);
+AttackArc getAttackArc(const HexCoord& attacker, const HexCoord& target, float targetFacing) {
+	return getAttackArc(attacker, target, ArcFacing(targetFacing));
+}
 
-	// Normalize to 0-360
-	if (targetAngle < 0)
-		targetAngle += 360.0f;
+bool isInFiringArc(const HexCoord& attacker, const ArcFacing& attackerFacing, const HexCoord& target) {
+	// Direction from attacker to target
+	HexDelta d = hexDelta(attacker, target);
+	int inArc = tableLookup(d, attackerFacing, kFiringArc, kFiringArcOnEdge, kFiringArcInside);
+	if (inArc != kStraddle)
+		return inArc != 0;
 
-	// Get relative angle
-	float relativeAngle = targetAngle - attackerFacing;
+	// Front 120° arc (±60° from facing)
+	Projection p = project(d, attackerFacing);
+	return p.dot >= 0.0 && 4.0 * p.dot * p.dot >= p.lengthSq;
+}
 
-	// Normalize to -180 to +180
-	while (relativeAngle > 180.0f)
-		relativeAngle -= 360.0f;
-	while (relativeAngle < -180.0f)
-		relativeAngle += 360.0f;
+bool isInFiringArc(const HexCoord& attacker, float attackerFacing, const HexCoord& target) {
+	return isInFiringArc(attacker, ArcFacing(attackerFacing), target);
+}
 
-	// Front 120° arc (±60° from facing)
-	return fabs(relativeAngle) <= 60.0f;
+float facingToward(const HexCoord& from, const HexCoord& to) {
+	HexDelta d = hexDelta(from, to);
+	float facing = (float)(std::atan2(kSqrt3 * d.b, (double)d.a) * (180.0 / PI));
+	if (facing < 0.0f)
+		facing += 360.0f;
+	return facing >= 360.0f ? 0.0f : facing;
 }
 
 Color getLineColor(AttackArc arc) {
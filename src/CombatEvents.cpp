@@ -0,0 +1,16 @@
+#include "CombatEvents.hpp"
+
+namespace combatevents {
+
+void CombatEventStream::subscribe(CombatEventHandler handler) {
+	handlers_.push_back(handler);
+}
+
+void CombatEventStream::emit(GameState& game, const CombatEvent& event) {
+	events_.push_back(event);
+	for (CombatEventHandler handler : handlers_) {
+		handler(game, event);
+	}
+}
+
+} // namespace combatevents
@@ -0,0 +1,206 @@
+#include "CombatLogStore.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace combatlog {
+
+// Indexed by LogTemplate
+static const char* const kTemplates[] = {
+    "=== Battle Start ===",
+    "--- Turn %d ---",
+    "%s turn begins",
+    "%s turn ended",
+    "---",
+    "Unit has already fired this turn",
+    "[COMBAT] %s (%s) fires at %s (%s)",
+    "[COMBAT] Target out of range",
+    "[HIT LOCATION] Attack from %s arc",
+    "[COMBAT] MISS!",
+    "[HIT LOCATION] Hit: %s",
+    "[COMBAT RESULT] %s (%s) DESTROYED!",
+    "[COMBAT RESULT] %s (%s) damaged",
+    "[DAMAGE] %d damage to %s",
+    "[DAMAGE] %s armor: %d -> %d (absorbed %d)",
+    "[DAMAGE] %d overflow to structure",
+    "[DAMAGE] %s structure: %d -> %d (absorbed %d)",
+    "[LOCATION DESTROYED] %s destroyed!",
+    "[MECH DEATH] Center destroyed!",
+    "[DAMAGE TRANSFER] %d overflow -> %s",
+    "[LOCATION STATUS] %s: %d/%d armor, %d/%d structure",
+    "Terrain is impassable",
+    "%s (%s) moves to (%d,%d)",
+    "Not enough movement points",
+};
+static_assert(sizeof(kTemplates) / sizeof(kTemplates[0]) == static_cast<size_t>(LogTemplate::COUNT),
+              "kTemplates must match LogTemplate");
+
+LogStore::LogStore(int capacity)
+    : ring_(std::max(capacity, 1)), resident_(0), total_(0), stringFile_(nullptr), flushed_(0), spill_(nullptr),
+      spilled_(0), pageFirst_(-1) {
+}
+
+LogStore::~LogStore() {
+	if (spill_)
+		std::fclose(spill_);
+	if (stringFile_)
+		std::fclose(stringFile_);
+}
+
+int LogStore::intern(std::string_view text) {
+	std::string key(text);
+	auto it = recentIds_.find(key);
+	if (it != recentIds_.end())
+		return it->second;
+
+	// Move the buffered tail to disk first, so the new string lands in memory
+	if ((int)(pending_.size() + key.size()) >= kStringBuffer && !pending_.empty()) {
+		if (!stringFile_)
+			stringFile_ = std::tmpfile();
+		if (stringFile_) {
+			std::fseek(stringFile_, flushed_, SEEK_SET);
+			std::fwrite(pending_.data(), 1, pending_.size(), stringFile_);
+		}
+		flushed_ += (int)pending_.size();
+		pending_.clear();
+	}
+
+	int id = flushed_ + (int)pending_.size();
+	pending_.append(key);
+	pending_.push_back('\0');
+
+	// Forgetting old ids only costs a duplicate copy later
+	if ((int)recentIds_.size() >= kMaxCachedStrings)
+		recentIds_.clear();
+	recentIds_.emplace(std::move(key), id);
+	return id;
+}
+
+const std::string* LogStore::lookup(int id) const {
+	if (id < 0 || id >= flushed_ + (int)pending_.size())
+		return nullptr;
+
+	auto it = readBack_.find(id);
+	if (it != readBack_.end())
+		return &it->second;
+
+	std::string text;
+	if (id >= flushed_) {
+		text = pending_.c_str() + (id - flushed_);
+	} else {
+		if (!stringFile_)
+			return nullptr;
+		std::fseek(stringFile_, id, SEEK_SET);
+		int c;
+		while ((c = std::fgetc(stringFile_)) != EOF && c != 0) {
+			text.push_back((char)c);
+		}
+	}
+
+	if ((int)readBack_.size() >= kMaxCachedStrings)
+		readBack_.clear();
+	return &readBack_.emplace(id, std::move(text)).first->second;
+}
+
+bool LogStore::push(LogTemplate id, int turn, std::initializer_list<LogArg> args) {
+	LogRecord record {};
+	record.templateId = static_cast<uint16_t>(id);
+	record.count = 1;
+	record.turn = turn;
+	int n = 0;
+	for (const LogArg& arg : args) {
+		if (n == kMaxLogArgs)
+			break;
+		record.args[n++] = arg.isText ? intern(arg.text) : arg.value;
+	}
+
+	// Fold consecutive repeats into one record
+	if (total_ > 0) {
+		LogRecord& last = ring_[slot(total_ - 1)];
+		if (last.count < UINT16_MAX && last.templateId == record.templateId && last.turn == record.turn &&
+		    std::memcmp(last.args, record.args, sizeof(record.args)) == 0) {
+			last.count++;
+			return false;
+		}
+	}
+
+	// Evict the oldest record to disk once the ring is full
+	if (resident_ == (int)ring_.size()) {
+		spill(ring_[slot(total_)]);
+		resident_--;
+	}
+
+	ring_[slot(total_)] = record;
+	total_++;
+	resident_++;
+	return true;
+}
+
+void LogStore::spill(const LogRecord& record) {
+	// Opened on first eviction, so short games (and headless battles)
+	// never touch the filesystem
+	if (!spill_)
+		spill_ = std::tmpfile();
+	if (spill_) {
+		std::fseek(spill_, (long)spilled_ * (long)sizeof(LogRecord), SEEK_SET);
+		std::fwrite(&record, sizeof(LogRecord), 1, spill_);
+	}
+	spilled_++;
+}
+
+void LogStore::clear() {
+	resident_ = 0;
+	total_ = 0;
+	spilled_ = 0;
+	pageFirst_ = -1;
+	page_.clear();
+}
+
+bool LogStore::get(int seq, LogRecord& out) const {
+	if (seq < 0 || seq >= total_)
+		return false;
+	if (seq >= firstResident()) {
+		out = ring_[slot(seq)];
+		return true;
+	}
+
+	// Evicted: serve from the cached page, or read the page holding seq
+	if (pageFirst_ < 0 || seq < pageFirst_ || seq >= pageFirst_ + (int)page_.size()) {
+		if (!spill_)
+			return false;
+		int first = seq - seq % kPageSize;
+		int count = std::min(kPageSize, spilled_ - first);
+		page_.resize(count);
+		std::fseek(spill_, (long)first * (long)sizeof(LogRecord), SEEK_SET);
+		size_t read = std::fread(page_.data(), sizeof(LogRecord), count, spill_);
+		page_.resize(read);
+		pageFirst_ = first;
+		if (seq >= first + (int)read)
+			return false;
+	}
+
+	out = page_[seq - pageFirst_];
+	return true;
+}
+
+void LogStore::format(const LogRecord& record, std::string& out) const {
+	out.clear();
+	if (record.templateId >= static_cast<uint16_t>(LogTemplate::COUNT))
+		return;
+
+	int arg = 0;
+	for (const char* p = kTemplates[record.templateId]; *p; p++) {
+		if (p[0] == '%' && (p[1] == 'd' || p[1] == 's') && arg < kMaxLogArgs) {
+			int value = record.args[arg++];
+			if (p[1] == 'd')
+				out += std::to_string(value);
+			else if (const std::string* text = lookup(value))
+				out += *text;
+			p++;
+		} else {
+			out += *p;
+		}
+	}
+}
+
+} // namespace combatlog
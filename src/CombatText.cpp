@@ -4,15 +4,16 @@
 #include "Rendering.hpp"
 
 #include <algorithm>
-#include <cstdlib>
 
 namespace gamelogic {
 
 void spawnCombatText(GameState& game, const HexCoord& targetHex, const std::string& text, bool isStructure) {
 	// Calculate random offset in normalized hex-relative coordinates
 	// These offsets will be scaled by hex size when calculating screen position
-	float randomX = (float)(std::rand() % 1000) / 1000.0f; // 0.0 to 1.0
-	float randomY = (float)(std::rand() % 1000) / 1000.0f; // 0.0 to 1.0
+	// Drawn from the cosmetic stream so they never shift combat rolls
+	rng::Pcg32& cosmetic = game.random.stream(rng::Stream::COSMETIC);
+	float randomX = (float)cosmetic.below(1000) / 1000.0f; // 0.0 to 1.0
+	float randomY = (float)cosmetic.below(1000) / 1000.0f; // 0.0 to 1.0
 
 	// Offset relative to hex center in hex-size units:
 	// Horizontal: -0.75 to +0.75 hex widths (spans into adjacent hexes)
@@ -30,6 +31,27 @@ void spawnCombatText(GameState& game, const HexCoord& targetHex, const std::stri
 	game.combatTexts.emplace_back(targetHex, hexOffset, text, isStructure, fadeIn, floatDur, floatSpeed);
 }
 
+void showCombatEventText(GameState& game, const combatevents::CombatEvent& event) {
+	using combatevents::CombatEventType;
+
+	// Only the location originally hit gets numbers, not transferred damage
+	switch (event.type) {
+		case CombatEventType::MISS:
+			spawnCombatText(game, event.defender->position, "MISS!", false);
+			break;
+		case CombatEventType::ARMOR_ABSORBED:
+			if (!event.transferred && event.amount > 0)
+				spawnCombatText(game, event.defender->position, std::to_string(event.amount), false);
+			break;
+		case CombatEventType::STRUCTURE_DAMAGED:
+			if (!event.transferred && event.amount > 0)
+				spawnCombatText(game, event.defender->position, std::to_string(event.amount), true);
+			break;
+		default:
+			break;
+	}
+}
+
 void updateCombatTexts(GameState& game, float deltaTime) {
 	// Create layout with current camera state
 	Layout layout = rendering::createHexLayout(HEX_SIZE, game.camera.offsetX,
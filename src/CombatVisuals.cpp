@@ -1,4 +1,5 @@
 #include <cmath>
+#include <cstdio>
 #include "CherryStyle.hpp"
 #include "CombatArcs.hpp"
 #include "Constants.hpp"
@@ -79,13 +80,13 @@ void drawTargetArcRing(GameState& game, Unit* unit) {
 }
 
 void drawAttackerFiringCone(GameState& game) {
-	if (!game.selectedUnit || !game.movementSel.isFacingSelection)
+	if (!game.selectedUnit() || !game.movementSel.isFacingSelection)
 		return;
 
 	Layout layout = createHexLayout(HEX_SIZE, game.camera.offsetX,
 	                                game.camera.offsetY, game.camera.zoom);
 
-	OffsetCoord unitOffset = gameCoordToOffset(game.selectedUnit->position);
+	OffsetCoord unitOffset = gameCoordToOffset(game.selectedUnit()->position);
 	::Hex unitCube = OffsetToCube(unitOffset);
 	Point center = HexToPixel(layout, unitCube);
 
@@ -180,6 +181,16 @@ void drawAttackLines(GameState& game) {
 			// Draw solid colored line for in-range targets
 			Color lineColor = combatarcs::getLineColor(line.arc);
 			DrawLineEx(fromVec, toVec, 3.0f, lineColor);
+
+			// Hit and kill odds at the midpoint
+			char oddsText[32];
+			snprintf(oddsText, sizeof(oddsText), "HIT %d%% KILL %d%%", (int)std::lround(line.odds.hitChance * 100.0),
+			         (int)std::lround(line.odds.killChance * 100.0));
+			float fontSize = (float)cherrystyle::kFontSize;
+			float spacing = (float)cherrystyle::kFontSpacing;
+			Vector2 size = MeasureTextEx(cherrystyle::CHERRY_FONT, oddsText, fontSize, spacing);
+			Vector2 textPos = {(fromVec.x + toVec.x - size.x) * 0.5f, (fromVec.y + toVec.y) * 0.5f - size.y};
+			DrawTextEx(cherrystyle::CHERRY_FONT, oddsText, textPos, fontSize, spacing, lineColor);
 		}
 	}
 }
@@ -1,5 +1,4 @@
 #include "DamageSystem.hpp"
-#include "PaperdollUI.hpp"
 
 #include <algorithm>
 #include "GameLogic.hpp"
@@ -20,61 +19,119 @@ ArmorLocation getTransferLocation(ArmorLocation destroyed) {
 	}
 }
 
-void applyDamageToLocation(GameState& game, Unit* target, ArmorLocation location, int damage) {
-	LocationStatus& loc = target->locations[location];
-
-	gamelogic::addLogMessage(game, "[DAMAGE] " + std::to_string(damage) + " damage to " + locationToString(location));
-
-	// Trigger hit flash on paperdoll panel
-	paperdollui::triggerHitFlash(game, target, location);
-
+LocationDamage damageLocation(LocationStatus& loc, int damage) {
+	LocationDamage result {};
 	int remainingDamage = damage;
 
 	// Apply to armor
 	if (loc.currentArmor > 0) {
-		int armorAbsorbed = std::min(loc.currentArmor, remainingDamage);
-		loc.currentArmor -= armorAbsorbed;
-		remainingDamage -= armorAbsorbed;
-
-		gamelogic::addLogMessage(game, "[DAMAGE] " + locationToString(location) + " armor: " + std::to_string(loc.currentArmor + armorAbsorbed) + " -> " + std::to_string(loc.currentArmor) + " (absorbed " + std::to_string(armorAbsorbed) + ")");
-
-		if (remainingDamage > 0) {
-			gamelogic::addLogMessage(game, "[DAMAGE] " + std::to_string(remainingDamage) + " overflow to structure");
-		}
+		result.hitArmor = true;
+		result.armorAbsorbed = std::min((int)loc.currentArmor, remainingDamage);
+		loc.currentArmor -= result.armorAbsorbed;
+		remainingDamage -= result.armorAbsorbed;
 	}
 
 	// Apply to structure
 	if (remainingDamage > 0 && loc.currentStructure > 0) {
-		int structureAbsorbed = std::min(loc.currentStructure, remainingDamage);
-		loc.currentStructure -= structureAbsorbed;
-		remainingDamage -= structureAbsorbed;
-
-		gamelogic::addLogMessage(game, "[DAMAGE] " + locationToString(location) + " structure: " + std::to_string(loc.currentStructure + structureAbsorbed) + " -> " + std::to_string(loc.currentStructure) + " (absorbed " + std::to_string(structureAbsorbed) + ")");
+		result.hitStructure = true;
+		result.structureAbsorbed = std::min((int)loc.currentStructure, remainingDamage);
+		loc.currentStructure -= result.structureAbsorbed;
+		remainingDamage -= result.structureAbsorbed;
 	}
 
 	// Check for location destruction
 	if (loc.currentStructure <= 0 && !loc.isDestroyed) {
 		loc.isDestroyed = true;
-		gamelogic::addLogMessage(game, "[LOCATION DESTROYED] " + locationToString(location) + " destroyed!");
+		result.destroyed = true;
+	}
+
+	result.overflow = remainingDamage;
+	return result;
+}
+
+int applyDamage(ArmorLocations& locations, ArmorLocation location, int damage) {
+	int absorbed = 0;
+	while (location != ArmorLocation::NONE) {
+		LocationDamage result = damageLocation(locations[location], damage);
+		absorbed += result.armorAbsorbed + result.structureAbsorbed;
+
+		// Only a location destroyed by this hit passes overflow on
+		if (!result.destroyed || result.overflow <= 0)
+			break;
+		location = getTransferLocation(location);
+		damage = result.overflow;
+	}
+	return absorbed;
+}
+
+void applyDamageToLocation(GameState& game, Unit* target, ArmorLocation location, int damage, bool transferred) {
+	using combatevents::CombatEvent;
+	using combatevents::CombatEventType;
+
+	LocationStatus& loc = target->locations[location];
+
+	CombatEvent hit(CombatEventType::LOCATION_HIT, nullptr, target);
+	hit.location = location;
+	hit.amount = damage;
+	hit.transferred = transferred;
+	game.combatEvents.emit(game, hit);
+
+	LocationDamage result = damageLocation(loc, damage);
+
+	if (result.hitArmor) {
+		CombatEvent armor(CombatEventType::ARMOR_ABSORBED, nullptr, target);
+		armor.location = location;
+		armor.amount = result.armorAbsorbed;
+		armor.before = loc.currentArmor + result.armorAbsorbed;
+		armor.after = loc.currentArmor;
+		armor.overflow = damage - result.armorAbsorbed;
+		armor.transferred = transferred;
+		game.combatEvents.emit(game, armor);
+	}
+
+	if (result.hitStructure) {
+		CombatEvent structure(CombatEventType::STRUCTURE_DAMAGED, nullptr, target);
+		structure.location = location;
+		structure.amount = result.structureAbsorbed;
+		structure.before = loc.currentStructure + result.structureAbsorbed;
+		structure.after = loc.currentStructure;
+		structure.transferred = transferred;
+		game.combatEvents.emit(game, structure);
+	}
+
+	if (result.destroyed) {
+		CombatEvent destroyed(CombatEventType::LOCATION_DESTROYED, nullptr, target);
+		destroyed.location = location;
+		destroyed.transferred = transferred;
+		game.combatEvents.emit(game, destroyed);
 
 		// Death condition: CENTER destroyed
 		if (location == ArmorLocation::CENTER) {
-			gamelogic::addLogMessage(game, "[MECH DEATH] Center destroyed!");
 			return;
 		}
 
 		// Transfer overflow damage to CENTER
-		if (remainingDamage > 0) {
+		if (result.overflow > 0) {
 			ArmorLocation transferLocation = getTransferLocation(location);
 			if (transferLocation != ArmorLocation::NONE) {
-				gamelogic::addLogMessage(game, "[DAMAGE TRANSFER] " + std::to_string(remainingDamage) + " overflow -> " + locationToString(transferLocation));
-				applyDamageToLocation(game, target, transferLocation, remainingDamage);
+				CombatEvent transfer(CombatEventType::DAMAGE_TRANSFERRED, nullptr, target);
+				transfer.location = location;
+				transfer.transferTo = transferLocation;
+				transfer.amount = result.overflow;
+				transfer.transferred = transferred;
+				game.combatEvents.emit(game, transfer);
+				applyDamageToLocation(game, target, transferLocation, result.overflow, true);
 			}
 		}
 	}
 
-	// Log final status
-	gamelogic::addLogMessage(game, "[LOCATION STATUS] " + locationToString(location) + ": " + std::to_string(loc.currentArmor) + "/" + std::to_string(loc.maxArmor) + " armor, " + std::to_string(loc.currentStructure) + "/" + std::to_string(loc.maxStructure) + " structure");
+	// Report final status
+	CombatEvent status(CombatEventType::LOCATION_STATUS, nullptr, target);
+	status.location = location;
+	status.armor = loc.currentArmor;
+	status.structure = loc.currentStructure;
+	status.transferred = transferred;
+	game.combatEvents.emit(game, status);
 }
 
 } // namespace damagesystem
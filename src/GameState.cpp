@@ -1,6 +1,7 @@
 #include "GameState.hpp"
+
+#include <algorithm>
 #include "Constants.hpp"
-#include "Raylib.hpp"
 
 // Resolution options
 const Resolution RESOLUTIONS[] = {
@@ -24,6 +25,76 @@ GameLayout::GameLayout() {
 	recalculate(SCREEN_WIDTH, SCREEN_HEIGHT);
 }
 
+// CombatLogLayout implementation
+CombatLogLayout::CombatLogLayout()
+    : lineStart {0}, baseRecord(0), offsetSpill(nullptr), cacheFirst(0), cacheEnd(0), lastCount(0), wrapWidth(0.0f) {
+}
+
+CombatLogLayout::~CombatLogLayout() {
+	if (offsetSpill)
+		std::fclose(offsetSpill);
+}
+
+int CombatLogLayout::lineOf(int record) const {
+	if (record >= baseRecord)
+		return lineStart[record - baseRecord];
+
+	int line = 0;
+	std::fseek(offsetSpill, (long)record * (long)sizeof(int), SEEK_SET);
+	if (std::fread(&line, sizeof(int), 1, offsetSpill) != 1)
+		return 0;
+	return line;
+}
+
+int CombatLogLayout::recordAt(int line) const {
+	if (line >= lineStart.front())
+		return baseRecord + (int)(std::upper_bound(lineStart.begin(), lineStart.end(), line) - lineStart.begin()) - 1;
+
+	// Binary search over the spilled offsets (only while scrolled far back)
+	int lo = 0;
+	int hi = baseRecord - 1;
+	while (lo < hi) {
+		int mid = (lo + hi + 1) / 2;
+		if (lineOf(mid) <= line)
+			lo = mid;
+		else
+			hi = mid - 1;
+	}
+	return lo;
+}
+
+void CombatLogLayout::append(int recordLines) {
+	lineStart.push_back(lineCount() + recordLines);
+
+	while ((int)lineStart.size() - 1 > kMaxResidentOffsets) {
+		// Opened on first spill; without a file the offsets just stay resident
+		if (!offsetSpill)
+			offsetSpill = std::tmpfile();
+		if (!offsetSpill)
+			return;
+		std::fseek(offsetSpill, (long)baseRecord * (long)sizeof(int), SEEK_SET);
+		std::fwrite(&lineStart.front(), sizeof(int), 1, offsetSpill);
+		lineStart.pop_front();
+		baseRecord++;
+	}
+}
+
+void CombatLogLayout::popBack() {
+	lineStart.pop_back();
+}
+
+void CombatLogLayout::clear() {
+	lineStart.assign(1, 0);
+	baseRecord = 0;
+	lastCount = 0;
+	dropCache();
+}
+
+void CombatLogLayout::dropCache() {
+	lines.clear();
+	cacheFirst = cacheEnd = 0;
+}
+
 // CombatLog implementation
 CombatLog::CombatLog()
     : scrollOffset(0.0f), maxScrollOffset(0.0f), isHovering(false), isDragging(false), dragOffset {0, 0} {
@@ -73,15 +144,36 @@ void UnitInfoBox::resetPosition() {
 // MovementSelection implementation
 void MovementSelection::reset() {
 	isFacingSelection = false;
-	oldPosition = {-1, -1};
-	oldMovesLeft = 0;
-	oldHasMoved = false;
 	selectedFacing = 0.0f;
 }
 
+// MoveHistory implementation
+void MoveHistory::push(const MoveRecord& record) {
+	records_.resize(cursor_); // A new move ends the redo branch
+	records_.push_back(record);
+	cursor_++;
+}
+
+const MoveRecord* MoveHistory::undo() {
+	return cursor_ > 0 ? &records_[--cursor_] : nullptr;
+}
+
+const MoveRecord* MoveHistory::redo() {
+	return cursor_ < records_.size() ? &records_[cursor_++] : nullptr;
+}
+
+// ReachabilityField implementation
+void ReachabilityField::pathTo(const HexCoord& coord, std::vector<HexCoord>& out) const {
+	if (!reaches(coord)) {
+		out.clear();
+		return;
+	}
+	search.pathTo(search.index(coord), out);
+}
+
 // GameState implementation
-GameState::GameState()
-    : selectedUnit(nullptr), currentTurn(1), currentPlayer(0), maxTurns(20), showOptionsMenu(false), showMechbayScreen(false), mechbayFilterFocused(false), showAttackLines(false) {
+GameState::GameState(uint64_t seed)
+    : currentTurn(1), currentPlayer(0), maxTurns(20), showOptionsMenu(false), showMechbayScreen(false), mechbayFilterFocused(false), showAttackLines(false), random(seed), occupancyRevision(0) {
 	initializeMap();
 	initializeMechBay();
 }
@@ -141,50 +233,85 @@ void GameState::initializeMechBay() {
 }
 
 void GameState::initializeMap() {
-	map.resize(MAP_ROWS);
-	for (int row = 0; row < MAP_ROWS; row++) {
-		map[row].resize(MAP_COLS);
-		for (int col = 0; col < MAP_COLS; col++) {
-			map[row][col].coord = {row, col};
-
-			// Wargame terrain generation with realistic distribution
-			int randVal = GetRandomValue(0, 100);
-			if (randVal < 35)
-				map[row][col].terrain = TerrainType::PLAINS; // 35% plains (most common)
-			else if (randVal < 55)
-				map[row][col].terrain = TerrainType::FOREST; // 20% forest
-			else if (randVal < 68)
-				map[row][col].terrain = TerrainType::HILL; // 13% hills
-			else if (randVal < 75)
-				map[row][col].terrain = TerrainType::ROUGH; // 7% rough
-			else if (randVal < 82)
-				map[row][col].terrain = TerrainType::DESERT; // 7% desert
-			else if (randVal < 87)
-				map[row][col].terrain = TerrainType::MOUNTAIN; // 5% mountain
-			else if (randVal < 91)
-				map[row][col].terrain = TerrainType::SWAMP; // 4% swamp
-			else if (randVal < 95)
-				map[row][col].terrain = TerrainType::CITY; // 4% city
-			else
-				map[row][col].terrain = TerrainType::WATER; // 5% water
-		}
+	map.resize(MAP_ROWS, MAP_COLS);
+	occupancy.assign(MAP_ROWS * MAP_COLS, nullptr);
+	sideUnits[0].resize(MAP_ROWS * MAP_COLS);
+	sideUnits[1].resize(MAP_ROWS * MAP_COLS);
+
+	for (int index = 0; index < map.size(); index++) {
+		// Wargame terrain generation with realistic distribution
+		TerrainType terrain;
+		int randVal = (int)random.stream(rng::Stream::MAP).below(101);
+		if (randVal < 35)
+			terrain = TerrainType::PLAINS; // 35% plains (most common)
+		else if (randVal < 55)
+			terrain = TerrainType::FOREST; // 20% forest
+		else if (randVal < 68)
+			terrain = TerrainType::HILL; // 13% hills
+		else if (randVal < 75)
+			terrain = TerrainType::ROUGH; // 7% rough
+		else if (randVal < 82)
+			terrain = TerrainType::DESERT; // 7% desert
+		else if (randVal < 87)
+			terrain = TerrainType::MOUNTAIN; // 5% mountain
+		else if (randVal < 91)
+			terrain = TerrainType::SWAMP; // 4% swamp
+		else if (randVal < 95)
+			terrain = TerrainType::CITY; // 4% city
+		else
+			terrain = TerrainType::WATER; // 5% water
+		map.setTerrain(index, terrain);
 	}
 }
 
 Unit* GameState::getUnitAt(const HexCoord& coord) {
-	for (auto& unit : units) {
-		// Skip dead units - they don't occupy hexes
-		if (!unit->isAlive())
-			continue;
-		if (unit->position == coord) {
-			return unit.get();
-		}
+	if (coord.row < 0 || coord.row >= MAP_ROWS || coord.col < 0 || coord.col >= MAP_COLS)
+		return nullptr;
+	// Dead units are removed from the index, so they never occupy hexes
+	return occupancy[coord.row * MAP_COLS + coord.col];
+}
+
+void GameState::relocateUnit(Unit* unit, const HexCoord& target) {
+	removeUnitFromMap(unit);
+	unit->position = target;
+	int index = target.row * MAP_COLS + target.col;
+	occupancy[index] = unit;
+	sideUnits[unit->side].set(index);
+	occupancyRevision++;
+}
+
+void GameState::removeUnitFromMap(Unit* unit) {
+	int index = unit->position.row * MAP_COLS + unit->position.col;
+	if (occupancy[index] == unit) {
+		occupancy[index] = nullptr;
+		sideUnits[unit->side].reset(index);
+		occupancyRevision++;
 	}
-	return nullptr;
 }
 
-void GameState::addUnit(UnitClass uClass, int side, int row, int col) {
-	auto unit = std::make_unique<Unit>();
+void GameState::newlyVisibleHexes(int side, visibility::HexBitset& out) const {
+	map.spotting(side).newlyVisible(out);
+}
+
+void GameState::hexesSeenByBothSides(visibility::HexBitset& out) const {
+	visibility::HexBitset::intersect(map.spotting(0).visible(), map.spotting(1).visible(), out);
+}
+
+void GameState::unspottedEnemyHexes(int side, visibility::HexBitset& out) const {
+	visibility::HexBitset::subtract(sideUnits[1 - side], map.spotting(side).visible(), out);
+}
+
+void GameState::spottedEnemyHexes(int side, visibility::HexBitset& out) const {
+	visibility::HexBitset::intersect(sideUnits[1 - side], map.spotting(side).visible(), out);
+}
+
+UnitHandle GameState::addUnit(UnitClass uClass, int side, int row, int col) {
+	// One unit per hex: the occupancy index has a single slot per hex
+	if (row < 0 || row >= MAP_ROWS || col < 0 || col >= MAP_COLS || occupancy[row * MAP_COLS + col])
+		return UnitHandle();
+
+	Unit *unit = units.get(units.create());
+	UnitDetails &details = units.details(*unit);
 	unit->unitClass = uClass;
 	unit->side = side;
 	unit->position = {row, col};
@@ -194,22 +321,22 @@ void GameState::addUnit(UnitClass uClass, int side, int row, int col) {
 	switch (uClass) {
 		case UnitClass::LIGHT:
 			wClass = Unit::WeightClass::LIGHT;
-			unit->name = "Light Mech";
+			details.name = "Light Mech";
 			unit->movMethod = MovMethod::LEG;
 			break;
 		case UnitClass::MEDIUM:
 			wClass = Unit::WeightClass::MEDIUM;
-			unit->name = "Medium Mech";
+			details.name = "Medium Mech";
 			unit->movMethod = MovMethod::WHEELED;
 			break;
 		case UnitClass::HEAVY:
 			wClass = Unit::WeightClass::HEAVY;
-			unit->name = "Heavy Mech";
+			details.name = "Heavy Mech";
 			unit->movMethod = MovMethod::HALF_TRACKED;
 			break;
 		case UnitClass::ASSAULT:
 			wClass = Unit::WeightClass::ASSAULT;
-			unit->name = "Assault Mech";
+			details.name = "Assault Mech";
 			unit->movMethod = MovMethod::TRACKED;
 			break;
 	}
@@ -218,7 +345,7 @@ void GameState::addUnit(UnitClass uClass, int side, int row, int col) {
 	unit->initializeLocations(wClass);
 
 	// Initialize weapons for this weight class
-	unit->initializeWeapons();
+	details.initializeWeapons(wClass);
 
 	// Initialize unit facing based on side (using degrees: E=0°, S=90°, W=180°, N=270°)
 	// Axis units (left side) face generally East (toward right/enemy)
@@ -229,5 +356,8 @@ void GameState::addUnit(UnitClass uClass, int side, int row, int col) {
 		unit->facing = 180.0f; // West (180°) - facing toward the left side of map
 	}
 
-	units.push_back(std::move(unit));
+	occupancy[row * MAP_COLS + col] = unit;
+	sideUnits[side].set(row * MAP_COLS + col);
+	occupancyRevision++;
+	return unit->handle;
 }
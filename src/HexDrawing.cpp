@@ -6,7 +6,10 @@
 #include "Raylib.hpp"
 #include "Raymath.hpp"
 #include "Rendering.hpp"
+#include "Rlgl.hpp"
 
+#include <algorithm>
+#include <climits>
 #include <cmath>
 #include <string>
 #include <vector>
@@ -23,6 +26,42 @@ Layout createHexLayout(float hexSize, float offsetX, float offsetY, float zoom)
 	return Layout(kLayoutPointy, size, origin);
 }
 
+HexRect getHexRectInView(const HexMap &map, const Layout &layout, Rectangle viewport) {
+	// Offset rows/cols are monotonic in screen y/x, so the hexes under the
+	// viewport corners bound the visible block. Pad by one for hexes that
+	// only poke in partially and for the odd-row shift.
+	Point corners[4] = {
+	    Point(viewport.x, viewport.y),
+	    Point(viewport.x + viewport.width, viewport.y),
+	    Point(viewport.x, viewport.y + viewport.height),
+	    Point(viewport.x + viewport.width, viewport.y + viewport.height)};
+
+	HexRect rect = {INT_MAX, INT_MIN, INT_MAX, INT_MIN};
+	for (const Point &corner : corners) {
+		OffsetCoord offset = CubeToOffset(HexRound(PixelToHex(layout, corner)));
+		rect.rowMin = std::min(rect.rowMin, offset.row);
+		rect.rowMax = std::max(rect.rowMax, offset.row);
+		rect.colMin = std::min(rect.colMin, offset.col);
+		rect.colMax = std::max(rect.colMax, offset.col);
+	}
+
+	rect.rowMin = std::max(rect.rowMin - 1, 0);
+	rect.rowMax = std::min(rect.rowMax + 1, map.rows() - 1);
+	rect.colMin = std::max(rect.colMin - 1, 0);
+	rect.colMax = std::min(rect.colMax + 1, map.cols() - 1);
+	return rect;
+}
+
+HexRect getVisibleHexRect(const GameState &game, Rectangle viewport) {
+	Layout layout = createHexLayout(HEX_SIZE, game.camera.offsetX,
+	                                game.camera.offsetY, game.camera.zoom);
+	return getHexRectInView(game.map, layout, viewport);
+}
+
+HexRect getVisibleHexRect(const GameState &game) {
+	return getVisibleHexRect(game, Rectangle {0, 0, (float)GetScreenWidth(), (float)GetScreenHeight()});
+}
+
 // Convert our game's row/col to hex library's offset coordinates
 OffsetCoord gameCoordToOffset(const HexCoord &coord) {
 	return OffsetCoord(coord.col, coord.row);
@@ -38,7 +77,7 @@ HexCoord offsetToGameCoord(const OffsetCoord &offset) {
 // ============================================================================
 
 // Draw a hexagon using raylib
-void drawHexagon(const std::vector<Point> &corners, Color color, bool filled) {
+void drawHexagon(const CornerTable &corners, Color color, bool filled) {
 	if (filled) {
 		// Draw filled hexagon using triangles from center
 		Vector2 center = {0, 0};
@@ -123,53 +162,225 @@ std::string getUnitSymbol(UnitClass uClass) {
 // MAIN MAP RENDERING
 // ============================================================================
 
+static MeshColor toMeshColor(Color color) {
+	return MeshColor {color.r, color.g, color.b, color.a};
+}
+
+// Rebuild the terrain mesh if terrain or hex size changed
+static TerrainMesh &ensureTerrainMesh(GameState &game) {
+	TerrainMesh &mesh = game.terrainMesh;
+	if (!mesh.matches(game.map.terrainRevision(), HEX_SIZE)) {
+		MeshColor palette[static_cast<int>(TerrainType::ROUGH) + 1];
+		for (int t = 0; t <= static_cast<int>(TerrainType::ROUGH); t++) {
+			palette[t] = toMeshColor(getTerrainColor(static_cast<TerrainType>(t)));
+		}
+		mesh.build(game.map, HEX_SIZE, palette, toMeshColor(kColorGrid), 2.0f);
+	}
+	return mesh;
+}
+
+void drawTerrainMesh(GameState &game, const HexRect &visible, float offsetX, float offsetY, float zoom) {
+	TerrainMesh &mesh = ensureTerrainMesh(game);
+	if (visible.empty())
+		return;
+
+	// Same placement as createHexLayout: map origin at the offset, scaled
+	// by zoom
+	const std::vector<MeshVertex> &vertices = mesh.vertices();
+	const uint32_t *indices = mesh.indices().data();
+	auto emit = [&](int begin, int end) {
+		for (int i = begin; i < end; i++) {
+			const MeshVertex &v = vertices[indices[i]];
+			rlColor4ub(v.color.r, v.color.g, v.color.b, v.color.a);
+			rlVertex2f(v.x, v.y);
+		}
+	};
+
+	rlPushMatrix();
+	rlTranslatef(offsetX, offsetY, 0.0f);
+	rlScalef(zoom, zoom, 1.0f);
+	rlBegin(RL_TRIANGLES);
+
+	// Each visible row segment is one contiguous index range; all fills
+	// first so the grid stays on top
+	for (int row = visible.rowMin; row <= visible.rowMax; row++) {
+		int first = game.map.index(row, visible.colMin);
+		emit(mesh.fillBegin(first), mesh.fillBegin(first + visible.colMax - visible.colMin + 1));
+	}
+	for (int row = visible.rowMin; row <= visible.rowMax; row++) {
+		int first = game.map.index(row, visible.colMin);
+		emit(mesh.gridBegin(first), mesh.gridBegin(first + visible.colMax - visible.colMin + 1));
+	}
+
+	rlEnd();
+	rlPopMatrix();
+}
+
+void unloadTerrainCache(GameState &game) {
+	TerrainLayerCache &cache = game.terrainCache;
+	for (RenderTexture2D &tile : cache.tiles) {
+		if (tile.id != 0)
+			UnloadRenderTexture(tile);
+	}
+	cache.tiles.clear();
+	cache.lastShown.clear();
+	cache.loadedTiles = 0;
+	cache.valid = false;
+}
+
+// Screen rectangle of one cache tile at the current camera offset
+static Rectangle terrainTileRect(const GameState &game, int tileRow, int tileCol) {
+	const TerrainLayerCache &cache = game.terrainCache;
+	float size = (float)TerrainLayerCache::kTileSize;
+	return Rectangle {game.camera.offsetX + cache.originX + tileCol * size,
+	                  game.camera.offsetY + cache.originY + tileRow * size, size, size};
+}
+
+void updateTerrainCache(GameState &game) {
+	TerrainLayerCache &cache = game.terrainCache;
+	TerrainMesh &mesh = ensureTerrainMesh(game);
+	float zoom = game.camera.zoom;
+
+	// Panning keeps the tiles; zoom, hex size or terrain changes drop them
+	if (!cache.valid || cache.zoom != zoom || cache.hexSize != HEX_SIZE || cache.terrainRevision != game.map.terrainRevision()) {
+		unloadTerrainCache(game);
+
+		float size = (float)TerrainLayerCache::kTileSize;
+		cache.originX = std::floor(mesh.minX() * zoom);
+		cache.originY = std::floor(mesh.minY() * zoom);
+		cache.tileCols = (int)std::ceil((mesh.maxX() * zoom - cache.originX) / size);
+		cache.tileRows = (int)std::ceil((mesh.maxY() * zoom - cache.originY) / size);
+		cache.tiles.assign((size_t)cache.tileCols * cache.tileRows, RenderTexture2D {});
+		cache.lastShown.assign(cache.tiles.size(), 0);
+		cache.zoom = zoom;
+		cache.hexSize = HEX_SIZE;
+		cache.terrainRevision = game.map.terrainRevision();
+		cache.valid = true;
+	}
+
+	// Render tiles that are on screen and not loaded
+	Rectangle screen = {0, 0, (float)GetScreenWidth(), (float)GetScreenHeight()};
+	cache.frame++;
+	for (int tileRow = 0; tileRow < cache.tileRows; tileRow++) {
+		for (int tileCol = 0; tileCol < cache.tileCols; tileCol++) {
+			int index = tileRow * cache.tileCols + tileCol;
+			RenderTexture2D &tile = cache.tiles[index];
+			if (!CheckCollisionRecs(terrainTileRect(game, tileRow, tileCol), screen))
+				continue;
+			cache.lastShown[index] = cache.frame;
+			if (tile.id != 0)
+				continue;
+
+			// Place the map so this tile's top-left lands on the texture origin
+			float offsetX = -(cache.originX + tileCol * (float)TerrainLayerCache::kTileSize);
+			float offsetY = -(cache.originY + tileRow * (float)TerrainLayerCache::kTileSize);
+			Layout layout = createHexLayout(HEX_SIZE, offsetX, offsetY, zoom);
+			Rectangle tileArea = {0, 0, (float)TerrainLayerCache::kTileSize, (float)TerrainLayerCache::kTileSize};
+
+			tile = LoadRenderTexture(TerrainLayerCache::kTileSize, TerrainLayerCache::kTileSize);
+			BeginTextureMode(tile);
+			ClearBackground(BLANK);
+			drawTerrainMesh(game, getHexRectInView(game.map, layout, tileArea), offsetX, offsetY, zoom);
+			EndTextureMode();
+			cache.loadedTiles++;
+		}
+	}
+
+	// Over the cap: unload off-screen tiles, least recently shown first
+	while (cache.loadedTiles > TerrainLayerCache::kMaxLoadedTiles) {
+		int oldest = -1;
+		for (int i = 0; i < (int)cache.tiles.size(); i++) {
+			if (cache.tiles[i].id != 0 && cache.lastShown[i] != cache.frame &&
+			    (oldest < 0 || cache.lastShown[i] < cache.lastShown[oldest]))
+				oldest = i;
+		}
+		if (oldest < 0)
+			break; // Every loaded tile is on screen
+		UnloadRenderTexture(cache.tiles[oldest]);
+		cache.tiles[oldest] = RenderTexture2D {};
+		cache.loadedTiles--;
+	}
+}
+
+void drawTerrainLayer(GameState &game, const HexRect &visible) {
+	TerrainLayerCache &cache = game.terrainCache;
+	bool ready = cache.valid && cache.zoom == game.camera.zoom && cache.hexSize == HEX_SIZE && cache.terrainRevision == game.map.terrainRevision();
+
+	Rectangle screen = {0, 0, (float)GetScreenWidth(), (float)GetScreenHeight()};
+	for (int tileRow = 0; ready && tileRow < cache.tileRows; tileRow++) {
+		for (int tileCol = 0; tileCol < cache.tileCols; tileCol++) {
+			if (CheckCollisionRecs(terrainTileRect(game, tileRow, tileCol), screen) && cache.tiles[tileRow * cache.tileCols + tileCol].id == 0) {
+				ready = false;
+				break;
+			}
+		}
+	}
+
+	// Cache not up to date for this frame (e.g. terrain edited mid-frame)
+	if (!ready) {
+		drawTerrainMesh(game, visible, game.camera.offsetX, game.camera.offsetY, game.camera.zoom);
+		return;
+	}
+
+	for (int tileRow = 0; tileRow < cache.tileRows; tileRow++) {
+		for (int tileCol = 0; tileCol < cache.tileCols; tileCol++) {
+			Rectangle dest = terrainTileRect(game, tileRow, tileCol);
+			if (!CheckCollisionRecs(dest, screen))
+				continue;
+
+			// Render textures are stored upside down
+			const RenderTexture2D &tile = cache.tiles[tileRow * cache.tileCols + tileCol];
+			Rectangle source = {0, 0, (float)tile.texture.width, -(float)tile.texture.height};
+			DrawTextureRec(tile.texture, source, Vector2 {dest.x, dest.y}, WHITE);
+		}
+	}
+}
+
 void drawMap(GameState &game) {
 	Layout layout = createHexLayout(HEX_SIZE, game.camera.offsetX,
 	                                game.camera.offsetY, game.camera.zoom);
 
-	// Draw hexes (all hexes always visible)
-	for (int row = 0; row < MAP_ROWS; row++) {
-		for (int col = 0; col < MAP_COLS; col++) {
-			GameHex &hex = game.map[row][col];
+	// Every map pass below is clipped to the hexes on screen
+	HexRect visible = getVisibleHexRect(game);
 
-			OffsetCoord offset = gameCoordToOffset(hex.coord);
-			::Hex cubeHex = OffsetToCube(offset);
-
-			std::vector<Point> corners = PolygonCorners(layout, cubeHex);
+	// Draw hexes (all hexes always visible) and the hex grid
+	drawTerrainLayer(game, visible);
 
-			// Draw terrain
-			Color terrainColor = getTerrainColor(hex.terrain);
-			drawHexagon(corners, terrainColor, true);
+	// Draw movement selection highlights
+	const visibility::HexBitset &moveSel = game.map.moveSel();
+	for (int row = visible.rowMin; row <= visible.rowMax; row++) {
+		for (int col = visible.colMin; col <= visible.colMax; col++) {
+			if (!moveSel.test(game.map.index(row, col)))
+				continue;
 
-			// Draw hex outline
-			drawHexagon(corners, kColorGrid, false);
+			OffsetCoord offset = gameCoordToOffset(HexCoord {row, col});
+			::Hex cubeHex = OffsetToCube(offset);
 
-			// Draw movement selection highlights
-			if (hex.isMoveSel) {
-				std::vector<Point> innerCorners;
-				Point center = HexToPixel(layout, cubeHex);
-				for (int i = 0; i < 6; i++) {
-					Point offset = HexCornerOffset(layout, i);
-					float scale = 0.85f;
-					innerCorners.push_back(Point(center.x + offset.x * scale,
-					                             center.y + offset.y * scale));
-				}
-				drawHexagon(innerCorners, Color {0, 255, 0, 100}, true);
+			CornerTable innerCorners;
+			Point center = HexToPixel(layout, cubeHex);
+			for (int i = 0; i < 6; i++) {
+				const Point &cornerOffset = layout.cornerOffsets[i];
+				float scale = 0.85f;
+				innerCorners[i] = Point(center.x + cornerOffset.x * scale,
+				                        center.y + cornerOffset.y * scale);
 			}
-			// Note: Red targeting box removed - using targeting lines only
+			drawHexagon(innerCorners, Color {0, 255, 0, 100}, true);
 		}
 	}
+	// Note: Red targeting box removed - using targeting lines only
 
 	// Draw units (friendly units always visible, enemy units only if spotted)
-	for (auto &unit : game.units) {
+	for (Unit *unit : game.units) {
 		// Skip dead units - they should not be rendered
 		if (!unit->isAlive())
 			continue;
 
-		GameHex &unitHex = game.map[unit->position.row][unit->position.col];
+		// Skip units off screen
+		if (!visible.contains(unit->position))
+			continue;
 
 		// Hide enemy units that aren't spotted (FOG OF WAR)
-		if (unit->side != game.currentPlayer && !unitHex.isSpotted(game.currentPlayer))
+		if (unit->side != game.currentPlayer && !game.isSpotted(game.currentPlayer, unit->position))
 			continue;
 
 		OffsetCoord offset = gameCoordToOffset(unit->position);
@@ -236,50 +447,39 @@ void drawMap(GameState &game) {
 	}
 
 	// Draw movement zone outline (yellow contiguous border)
-	if (game.selectedUnit && !game.selectedUnit->hasMoved) {
+	if (game.selectedUnit() && !game.selectedUnit()->hasMoved) {
 		Layout layout = createHexLayout(HEX_SIZE, game.camera.offsetX,
 		                                game.camera.offsetY, game.camera.zoom);
 
-		// Find edge hexes (hexes with at least one neighbor that's not moveable)
-		for (int row = 0; row < MAP_ROWS; row++) {
-			for (int col = 0; col < MAP_COLS; col++) {
-				if (!game.map[row][col].isMoveSel)
-					continue;
-
-				HexCoord coord = {row, col};
-				OffsetCoord offset = gameCoordToOffset(coord);
-				::Hex cubeHex = OffsetToCube(offset);
-
-				// Check each of the 6 edges
-				for (int dir = 0; dir < 6; dir++) {
-					::Hex neighbor = HexNeighbor(cubeHex, dir);
-					OffsetCoord neighborOffset = CubeToOffset(neighbor);
-
-					// CRITICAL: Convert offset coordinates back to game coordinates before map lookup
-					HexCoord neighborCoord = offsetToGameCoord(neighborOffset);
-
-					bool drawEdge = false;
-
-					// Draw edge if neighbor is out of bounds or not in movement range
-					if (neighborCoord.row < 0 || neighborCoord.row >= MAP_ROWS || neighborCoord.col < 0 || neighborCoord.col >= MAP_COLS) {
-						drawEdge = true;
-					} else if (!game.map[neighborCoord.row][neighborCoord.col].isMoveSel) {
-						drawEdge = true;
-					}
-
-					if (drawEdge) {
-						// Draw the edge between this hex and its neighbor
-						// CRITICAL: Direction numbering doesn't match edge numbering!
-						// For pointy-top hexes, direction → edge mapping is: dir → (5 - dir)
-						// Direction 0 (E) uses edge 5, Direction 1 (SE) uses edge 4, etc.
-						std::vector<Point> corners = PolygonCorners(layout, cubeHex);
-						int edgeIndex = (5 - dir + 6) % 6; // Correct edge for this direction
-						Point p1 = corners[edgeIndex];
-						Point p2 = corners[(edgeIndex + 1) % 6];
-						DrawLineEx(Vector2 {(float)p1.x, (float)p1.y},
-						           Vector2 {(float)p2.x, (float)p2.y},
-						           3.0f * game.camera.zoom, YELLOW);
-					}
+		// Find edge hexes (hexes with at least one neighbor that's not moveable).
+		// Only hexes in the cached reachability field can be highlighted.
+		const ReachabilityField &reach = gamelogic::getReachability(game, game.selectedUnit());
+		for (int index : reach.search.settled()) {
+			HexCoord coord = reach.search.coord(index);
+			if (!visible.contains(coord) || !game.map.moveSel().test(index))
+				continue;
+
+			OffsetCoord offset = gameCoordToOffset(coord);
+			::Hex cubeHex = OffsetToCube(offset);
+			CornerTable corners = HexCorners(layout, cubeHex);
+
+			// Check each of the 6 edges
+			const int *neighbors = game.map.topology().neighbors(index);
+			for (int dir = 0; dir < HexTopology::kDirections; dir++) {
+				// Draw edge if neighbor is out of bounds (-1) or not in movement range
+				bool drawEdge = neighbors[dir] < 0 || !game.map.moveSel().test(neighbors[dir]);
+
+				if (drawEdge) {
+					// Draw the edge between this hex and its neighbor
+					// CRITICAL: Direction numbering doesn't match edge numbering!
+					// For pointy-top hexes, direction → edge mapping is: dir → (5 - dir)
+					// Direction 0 (E) uses edge 5, Direction 1 (SE) uses edge 4, etc.
+					int edgeIndex = (5 - dir + 6) % 6; // Correct edge for this direction
+					Point p1 = corners[edgeIndex];
+					Point p2 = corners[(edgeIndex + 1) % 6];
+					DrawLineEx(Vector2 {(float)p1.x, (float)p1.y},
+					           Vector2 {(float)p2.x, (float)p2.y},
+					           3.0f * game.camera.zoom, YELLOW);
 				}
 			}
 		}
@@ -287,7 +487,7 @@ void drawMap(GameState &game) {
 
 	// Draw path preview (semi-transparent snake showing planned path)
 	// Only show in Phase 1 (before moving)
-	if (game.selectedUnit && !game.movementSel.isFacingSelection && !game.selectedUnit->hasMoved) {
+	if (game.selectedUnit() && !game.movementSel.isFacingSelection && !game.selectedUnit()->hasMoved) {
 		Vector2 mousePos = GetMousePosition();
 		Layout layout = createHexLayout(HEX_SIZE, game.camera.offsetX,
 		                                game.camera.offsetY, game.camera.zoom);
@@ -298,18 +498,20 @@ void drawMap(GameState &game) {
 		HexCoord hoveredHex = offsetToGameCoord(offset);
 
 		// Only show path if hovering over a valid movement hex
-		if (hoveredHex.row >= 0 && hoveredHex.row < MAP_ROWS && hoveredHex.col >= 0 && hoveredHex.col < MAP_COLS && game.map[hoveredHex.row][hoveredHex.col].isMoveSel) {
-			// Get path from unit position to hovered hex
-			std::vector<HexCoord> path = gamelogic::findPath(game, game.selectedUnit,
-			                                                 game.selectedUnit->position,
-			                                                 hoveredHex);
+		if (game.map.inBounds(hoveredHex) && game.map.isMoveSel(hoveredHex)) {
+			// Walk the cached reachability parents back to the unit
+			std::vector<HexCoord> path;
+			gamelogic::getReachability(game, game.selectedUnit()).pathTo(hoveredHex, path);
 
 			if (!path.empty() && path.size() > 1) {
 				// Draw path as semi-transparent hexes
 				for (size_t i = 1; i < path.size(); i++) { // Start at 1 to skip unit's current position
+					if (!visible.contains(path[i]))
+						continue;
+
 					OffsetCoord pathOffset = gameCoordToOffset(path[i]);
 					::Hex pathCube = OffsetToCube(pathOffset);
-					std::vector<Point> corners = PolygonCorners(layout, pathCube);
+					CornerTable corners = HexCorners(layout, pathCube);
 
 					// Draw semi-transparent yellow fill
 					drawHexagon(corners, Color {255, 255, 0, 80}, true);
@@ -318,7 +520,7 @@ void drawMap(GameState &game) {
 				// Draw target hex with slightly more opacity
 				OffsetCoord targetOffset = gameCoordToOffset(hoveredHex);
 				::Hex targetCube = OffsetToCube(targetOffset);
-				std::vector<Point> corners = PolygonCorners(layout, targetCube);
+				CornerTable corners = HexCorners(layout, targetCube);
 				drawHexagon(corners, Color {255, 255, 0, 120}, true);
 			}
 		}
@@ -328,8 +530,8 @@ void drawMap(GameState &game) {
 	drawAttackLines(game);
 
 	// Draw target arc ring for selected unit (when not in facing selection mode)
-	if (game.selectedUnit && !game.movementSel.isFacingSelection) {
-		drawTargetArcRing(game, game.selectedUnit);
+	if (game.selectedUnit() && !game.movementSel.isFacingSelection) {
+		drawTargetArcRing(game, game.selectedUnit());
 	}
 
 	// Draw attacker firing cone during facing selection
@@ -337,12 +539,7 @@ void drawMap(GameState &game) {
 }
 
 void clearSelectionHighlights(GameState &game) {
-	for (int row = 0; row < MAP_ROWS; row++) {
-		for (int col = 0; col < MAP_COLS; col++) {
-			game.map[row][col].isMoveSel = false;
-			game.map[row][col].isAttackSel = false;
-		}
-	}
+	game.map.clearSelection();
 }
 
 } // namespace rendering
@@ -0,0 +1,21 @@
+#include "HexMap.hpp"
+
+HexMap::HexMap()
+    : rows_(0), cols_(0), terrainRevision_(0) {
+}
+
+void HexMap::resize(int rows, int cols) {
+	rows_ = rows;
+	cols_ = cols;
+	int count = rows * cols;
+	topology_.build(rows, cols);
+
+	terrain_.assign(count, static_cast<uint8_t>(TerrainType::PLAINS));
+	owner_.assign(count, -1);
+	deployment_.resize(count);
+	moveSel_.resize(count);
+	attackSel_.resize(count);
+	spotting_[0].resize(count);
+	spotting_[1].resize(count);
+	terrainRevision_++;
+}
@@ -0,0 +1,26 @@
+#include "HexTopology.hpp"
+
+#include <cstddef>
+
+HexTopology::HexTopology()
+    : rows_(0), cols_(0) {
+}
+
+void HexTopology::build(int rows, int cols) {
+	rows_ = rows;
+	cols_ = cols;
+	table_.assign((size_t)rows * (size_t)cols * kDirections, -1);
+
+	int* slot = table_.data();
+	for (int row = 0; row < rows; row++) {
+		const int(*deltas)[2] = (row & 1) ? kOddRowNeighbors : kEvenRowNeighbors;
+		for (int col = 0; col < cols; col++) {
+			for (int dir = 0; dir < kDirections; dir++, slot++) {
+				int nRow = row + deltas[dir][1];
+				int nCol = col + deltas[dir][0];
+				if (nRow >= 0 && nRow < rows && nCol >= 0 && nCol < cols)
+					*slot = nRow * cols + nCol;
+			}
+		}
+	}
+}
@@ -1,19 +1,8 @@
 #include "HitTables.hpp"
-#include <cstdlib>
 
 namespace hittables {
 
-ArmorLocation rollHitLocation(combatarcs::AttackArc arc) {
-	// Simplified hit location: 90% chance to hit arc-appropriate location,
-	// 10% chance to hit CENTER instead
-	int roll = rand() % 100;
-
-	// 10% chance to hit CENTER regardless of arc
-	if (roll < 10) {
-		return ArmorLocation::CENTER;
-	}
-
-	// 90% chance to hit the arc-appropriate location
+ArmorLocation arcLocation(combatarcs::AttackArc arc) {
 	switch (arc) {
 		case combatarcs::AttackArc::FRONT:
 			return ArmorLocation::FRONT;
@@ -32,4 +21,25 @@ ArmorLocation rollHitLocation(combatarcs::AttackArc arc) {
 	}
 }
 
+ArmorLocation rollHitLocation(combatarcs::AttackArc arc, rng::Pcg32& rng) {
+	// Simplified hit location: 90% chance to hit arc-appropriate location,
+	// 10% chance to hit CENTER instead
+	int roll = (int)rng.below(100);
+
+	// 10% chance to hit CENTER regardless of arc
+	if (roll < kCenterHitPercent) {
+		return ArmorLocation::CENTER;
+	}
+
+	// 90% chance to hit the arc-appropriate location
+	return arcLocation(arc);
+}
+
+bool rollAttack(combatarcs::AttackArc arc, rng::RandomService& random, ArmorLocation& location) {
+	if ((int)random.stream(rng::Stream::COMBAT).below(100) < kMissPercent)
+		return false;
+	location = rollHitLocation(arc, random.stream(rng::Stream::HIT_TABLE));
+	return true;
+}
+
 } // namespace hittables
@@ -0,0 +1,109 @@
+#include "LineOfSight.hpp"
+#include "Hex.hpp"
+
+#include <algorithm>
+
+namespace los {
+
+int terrainOpacity(TerrainType terrain) {
+	switch (terrain) {
+		case TerrainType::MOUNTAIN:
+		case TerrainType::CITY:
+			return kOpaque;
+		case TerrainType::FOREST:
+			return kObscuring;
+		default:
+			return kClear;
+	}
+}
+
+SightEngine::SightEngine()
+    : terrainRevision(0), rows_(0), cols_(0), stencilRange_(0) {
+	ringEnd_.push_back(0); // Ring 0 (the viewer) has no rays
+}
+
+void SightEngine::resize(int rows, int cols) {
+	rows_ = rows;
+	cols_ = cols;
+	opacity_.assign((size_t)rows * (size_t)cols, kClear);
+}
+
+void SightEngine::growStencil(int range) {
+	for (int ring = stencilRange_ + 1; ring <= range; ring++) {
+		// Walk the ring starting from the direction-4 corner (Red Blob order)
+		::Hex target = HexDirection(4) * ring;
+		for (int side = 0; side < 6; side++) {
+			for (int i = 0; i < ring; i++) {
+				Ray ray;
+				ray.dq = target.q;
+				ray.dr = target.r;
+				ray.stepBegin = (int)steps_.size();
+
+				int n = 0;
+				HexLinedrawEach(::Hex(0, 0, 0), target, [&](::Hex h) {
+					if (n > 0 && n < ring) {
+						steps_.push_back({h.q, h.r});
+					}
+					n++;
+					return true;
+				});
+
+				ray.stepEnd = (int)steps_.size();
+				rays_.push_back(ray);
+				target = HexNeighbor(target, side);
+			}
+		}
+		ringEnd_.push_back((int)rays_.size());
+	}
+	stencilRange_ = std::max(stencilRange_, range);
+}
+
+void SightEngine::computeVisible(const HexCoord& origin, int range, std::vector<int>& out) {
+	out.clear();
+	if (origin.row < 0 || origin.row >= rows_ || origin.col < 0 || origin.col >= cols_)
+		return;
+	if (range > stencilRange_)
+		growStencil(range);
+
+	int q0 = origin.col - (origin.row - (origin.row & 1)) / 2;
+	int r0 = origin.row;
+	out.push_back(origin.row * cols_ + origin.col);
+
+	const Step* steps = steps_.data();
+	for (int i = 0, end = ringEnd_[range]; i < end; i++) {
+		const Ray& ray = rays_[i];
+		int r = r0 + ray.dr;
+		int col = (q0 + ray.dq) + (r - (r & 1)) / 2;
+		if (r < 0 || r >= rows_ || col < 0 || col >= cols_)
+			continue;
+
+		int sum = 0;
+		for (int s = ray.stepBegin; s < ray.stepEnd && sum < kOpaque; s++) {
+			sum += opacityAt(q0 + steps[s].dq, r0 + steps[s].dr);
+		}
+		if (sum < kOpaque) {
+			out.push_back(r * cols_ + col);
+		}
+	}
+
+	std::sort(out.begin(), out.end());
+}
+
+bool SightEngine::hasLineOfSight(const HexCoord& from, const HexCoord& to) const {
+	::Hex a = OffsetToCube(OffsetCoord(from.col, from.row));
+	::Hex b = OffsetToCube(OffsetCoord(to.col, to.row));
+	int n = HexDistance(a, b);
+
+	// Walk the line relative to the viewer so it matches the stencil exactly
+	int i = 0, sum = 0;
+	HexLinedrawEach(::Hex(0, 0, 0), b - a, [&](::Hex h) {
+		if (i > 0 && i < n) {
+			sum += opacityAt(a.q + h.q, a.r + h.r);
+		}
+		i++;
+		return sum < kOpaque;
+	});
+	return sum < kOpaque;
+}
+
+} // namespace los
@@ -13,6 +13,7 @@
 #include "Raygui.hpp"
 #pragma GCC diagnostic pop
 
+#include "AiPlayer.hpp"
 #include "CherryStyle.hpp"
 #include "Config.hpp"
 #include "Constants.hpp"
@@ -25,6 +26,8 @@
 #include "Rendering.hpp"
 #include "UIPanels.hpp"
 
+#include <ctime>
+
 int main() {
 	// Create temporary settings to load config before window init
 	VideoSettings tempSettings;
@@ -59,7 +62,8 @@ int main() {
 	// Initialize Cherry UI style
 	cherrystyle::InitializeCherryStyle();
 
-	GameState game;
+	// A new battlefield each launch, as with raylib's time-seeded generator
+	GameState game((uint64_t)std::time(nullptr));
 	// Apply loaded settings to game state
 	game.settings = tempSettings;
 
@@ -67,28 +71,20 @@ int main() {
 	input::calculateCenteredCameraOffset(game.camera, SCREEN_WIDTH, SCREEN_HEIGHT);
 
 	// Add some initial units (BattleTech mech weight classes)
-	game.addUnit(UnitClass::LIGHT, 0, 2, 2);
+	UnitHandle stripped0 = game.addUnit(UnitClass::LIGHT, 0, 2, 2);
 	game.addUnit(UnitClass::MEDIUM, 0, 2, 3);
 	game.addUnit(UnitClass::HEAVY, 0, 1, 2);
 
-	game.addUnit(UnitClass::LIGHT, 1, 8, 10);
+	UnitHandle stripped1 = game.addUnit(UnitClass::LIGHT, 1, 8, 10);
 	game.addUnit(UnitClass::MEDIUM, 1, 9, 10);
 	game.addUnit(UnitClass::ASSAULT, 1, 8, 11);
 
 	// Set one mech per side to have 0 armor (but full structure) for testing
 	// This tests the orange structure pattern display
-	if (game.units.size() >= 1) {
-		// First unit (side 0) - strip all armor
-		Unit* unit0 = game.units[0].get();
-		for (auto& loc : unit0->locations) {
-			loc.second.currentArmor = 0;
-		}
-	}
-	if (game.units.size() >= 4) {
-		// Fourth unit (side 1) - strip all armor
-		Unit* unit1 = game.units[3].get();
-		for (auto& loc : unit1->locations) {
-			loc.second.currentArmor = 0;
+	for (UnitHandle handle : {stripped0, stripped1}) {
+		// First unit of each side - strip all armor
+		for (LocationStatus& loc : game.units.get(handle)->locations) {
+			loc.currentArmor = 0;
 		}
 	}
 
@@ -99,13 +95,35 @@ int main() {
 	uipanel::initializeTargetPanel(game);
 	uipanel::initializePlayerPanel(game);
 
+	// Present attack results from the combat event stream
+	game.combatEvents.subscribe(gamelogic::logCombatEvent);
+	game.combatEvents.subscribe(gamelogic::showCombatEventText);
+	game.combatEvents.subscribe(paperdollui::flashCombatEvent);
+	game.hooks.turnEnded = uipanel::onTurnEnded;
+
 	// Add initial combat log messages
-	gamelogic::addLogMessage(game, "=== Battle Start ===");
-	gamelogic::addLogMessage(game, "Axis turn begins");
+	gamelogic::addLogMessage(game, combatlog::LogTemplate::BATTLE_START);
+	gamelogic::addLogMessage(game, combatlog::LogTemplate::TURN_BEGINS, {"Axis"});
 
 	bool needsRestart = false;
 
+	// Plans side 1's turns off the main thread
+	ai::AiController aiPlayer;
+
 	while (!WindowShouldClose()) {
+		// The map stays live (camera, log, panels) while the AI thinks; its
+		// plan is carried out in one go once the search finishes
+		bool aiTurn = game.settings.aiOpponent && game.currentPlayer == 1;
+		if (aiTurn) {
+			ai::TurnPlan plan;
+			if (!aiPlayer.thinking()) {
+				aiPlayer.begin(game, game.currentPlayer, game.settings.aiTurnBudgetMs);
+			} else if (aiPlayer.poll(plan)) {
+				ai::applyPlan(game, plan);
+				gamelogic::endTurn(game);
+			}
+		}
+
 		// Input handling (only when menus are closed)
 		if (!game.showOptionsMenu && !game.showMechbayScreen) {
 			// Handle paperdoll panel dragging (must be before selection)
@@ -126,7 +144,7 @@ int main() {
 			// Handle middle mouse panning
 			input::handlePan(game);
 
-			if (IsKeyPressed(KEY_SPACE)) {
+			if (IsKeyPressed(KEY_SPACE) && !aiTurn) {
 				gamelogic::endTurn(game);
 			}
 
@@ -135,28 +153,24 @@ int main() {
 			}
 
 			// Right-click handling (undo or deselect)
-			if (IsMouseButtonPressed(MOUSE_RIGHT_BUTTON)) {
-				if (game.movementSel.isFacingSelection && game.selectedUnit) {
+			if (IsMouseButtonPressed(MOUSE_RIGHT_BUTTON) && !aiTurn) {
+				if (game.movementSel.isFacingSelection && game.selectedUnit()) {
 					// Phase 2: Right-click undoes the movement
-					// Note: spotting was never updated during tentative move, so no need to clear it
-
-					game.selectedUnit->position = game.movementSel.oldPosition;
-					game.selectedUnit->movesLeft = game.movementSel.oldMovesLeft;
-					game.selectedUnit->hasMoved = game.movementSel.oldHasMoved;
-
-					// Note: spotting is still at old position from before the tentative move
+					// Note: spotting was never updated during tentative move, so it is
+					// still at the old position
+					gamelogic::undoMove(game);
 
 					// Return to Phase 1
 					game.movementSel.reset();
 					rendering::clearSelectionHighlights(game);
-					gamelogic::highlightMovementRange(game, game.selectedUnit);
+					gamelogic::highlightMovementRange(game, game.selectedUnit());
 
 					// Update attack lines for returned position
 					gamelogic::updateAttackLines(game);
 					game.showAttackLines = true;
-				} else if (game.selectedUnit) {
+				} else if (game.selectedUnit()) {
 					// Phase 1: deselect
-					game.selectedUnit = nullptr;
+					game.selected = UnitHandle();
 					game.movementSel.reset();
 					rendering::clearSelectionHighlights(game);
 					game.showAttackLines = false;
@@ -166,15 +180,33 @@ int main() {
 				}
 			}
 
+			// Ctrl+Z / Ctrl+Y step through this turn's moves
+			bool ctrlDown = IsKeyDown(KEY_LEFT_CONTROL) || IsKeyDown(KEY_RIGHT_CONTROL);
+			if (ctrlDown && !aiTurn && !game.movementSel.isFacingSelection && (IsKeyPressed(KEY_Z) || IsKeyPressed(KEY_Y))) {
+				Unit* moved = IsKeyPressed(KEY_Z) ? gamelogic::undoMove(game) : gamelogic::redoMove(game);
+				if (moved) {
+					// Select the unit that moved, as if just clicked
+					game.selected = moved->handle;
+					game.movementSel.reset();
+					rendering::clearSelectionHighlights(game);
+					if (!moved->hasMoved) {
+						gamelogic::highlightMovementRange(game, moved);
+					}
+					gamelogic::highlightAttackRange(game, moved);
+					gamelogic::updateAttackLines(game);
+					game.showAttackLines = true;
+				}
+			}
+
 			// Update facing preview in Phase 2
-			if (game.selectedUnit && game.movementSel.isFacingSelection) {
+			if (game.selectedUnit() && game.movementSel.isFacingSelection) {
 				Vector2 mousePos = GetMousePosition();
 				Layout layout = rendering::createHexLayout(HEX_SIZE, game.camera.offsetX,
 				                                           game.camera.offsetY, game.camera.zoom);
 				Point mousePoint(mousePos.x, mousePos.y);
 
 				game.movementSel.selectedFacing = gamelogic::calculateFacingFromPoint(
-				    game.selectedUnit->position, mousePoint, layout);
+				    game.selectedUnit()->position, mousePoint, layout);
 
 				// Update attack lines based on preview facing
 				gamelogic::updateAttackLines(game);
@@ -184,7 +216,7 @@ int main() {
 			// Left-click handling (skip if interacting with draggable UI elements)
 			Vector2 clickMousePos = GetMousePosition();
 			bool clickedPaperdoll = (game.targetPanel.isVisible && CheckCollisionPointRec(clickMousePos, game.targetPanel.bounds)) || (game.playerPanel.isVisible && CheckCollisionPointRec(clickMousePos, game.playerPanel.bounds));
-			if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && !game.combatLog.isDragging && !game.unitInfoBox.isDragging && !game.targetPanel.isDragging && !game.playerPanel.isDragging && !clickedPaperdoll) {
+			if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON) && !aiTurn && !game.combatLog.isDragging && !game.unitInfoBox.isDragging && !game.targetPanel.isDragging && !game.playerPanel.isDragging && !clickedPaperdoll) {
 				Vector2 mousePos = GetMousePosition();
 				Layout layout = rendering::createHexLayout(HEX_SIZE, game.camera.offsetX,
 				                                           game.camera.offsetY, game.camera.zoom);
@@ -198,19 +230,14 @@ int main() {
 					Unit* clickedUnit = game.getUnitAt(clickedHex);
 
 					// Phase 2: confirming facing
-					if (game.selectedUnit && game.movementSel.isFacingSelection) {
-						game.selectedUnit->facing = game.movementSel.selectedFacing;
-
-						// Now that movement is confirmed, update spotting (clear old, set new)
-						gamelogic::setSpotRangeAtPosition(game, game.selectedUnit->side,
-						                                  game.selectedUnit->spotRange,
-						                                  game.movementSel.oldPosition, false);
-						gamelogic::setUnitSpotRange(game, game.selectedUnit, true);
+					if (game.selectedUnit() && game.movementSel.isFacingSelection) {
+						// Now that movement is confirmed, move spotting to the new position
+						gamelogic::confirmMove(game, game.selectedUnit(), game.movementSel.selectedFacing);
 
 						game.movementSel.reset();
 						rendering::clearSelectionHighlights(game);
-						if (!game.selectedUnit->hasFired) {
-							gamelogic::highlightAttackRange(game, game.selectedUnit);
+						if (!game.selectedUnit()->hasFired) {
+							gamelogic::highlightAttackRange(game, game.selectedUnit());
 						}
 
 						// Keep attack lines visible after confirming facing
@@ -218,57 +245,42 @@ int main() {
 						game.showAttackLines = true;
 					}
 					// Phase 1: movement or attack
-					else if (game.selectedUnit && !game.movementSel.isFacingSelection) {
-						if (game.map[clickedHex.row][clickedHex.col].isMoveSel && !game.selectedUnit->hasMoved) {
-							std::vector<HexCoord> path = gamelogic::findPath(game, game.selectedUnit,
-							                                                 game.selectedUnit->position,
-							                                                 clickedHex);
-							if (!path.empty()) {
-								game.movementSel.oldPosition = game.selectedUnit->position;
-								game.movementSel.oldMovesLeft = game.selectedUnit->movesLeft;
-								game.movementSel.oldHasMoved = game.selectedUnit->hasMoved;
-
+					else if (game.selectedUnit() && !game.movementSel.isFacingSelection) {
+						if (game.map.isMoveSel(clickedHex) && !game.selectedUnit()->hasMoved) {
+							const ReachabilityField& reach = gamelogic::getReachability(game, game.selectedUnit());
+							if (reach.reaches(clickedHex)) {
 								// Move without updating spotting (defer until facing confirmation)
-								gamelogic::moveUnit(game, game.selectedUnit, clickedHex, false);
+								gamelogic::moveUnit(game, game.selectedUnit(), clickedHex, false);
 								rendering::clearSelectionHighlights(game);
 								game.movementSel.isFacingSelection = true;
-								game.movementSel.selectedFacing = game.selectedUnit->facing;
+								game.movementSel.selectedFacing = game.selectedUnit()->facing;
 							}
-						} else if (game.map[clickedHex.row][clickedHex.col].isAttackSel) {
+						} else if (game.map.isAttackSel(clickedHex)) {
 							if (clickedUnit) {
 								// Show target panel during attack
-								Layout attackLayout = rendering::createHexLayout(HEX_SIZE, game.camera.offsetX,
-								                                                 game.camera.offsetY, game.camera.zoom);
-								OffsetCoord atkOffset = rendering::gameCoordToOffset(game.selectedUnit->position);
-								OffsetCoord defOffset = rendering::gameCoordToOffset(clickedUnit->position);
-								::Hex atkCube = OffsetToCube(atkOffset);
-								::Hex defCube = OffsetToCube(defOffset);
-								Point atkPixel = HexToPixel(attackLayout, atkCube);
-								Point defPixel = HexToPixel(attackLayout, defCube);
-								Vector2 atkPos = {(float)atkPixel.x, (float)atkPixel.y};
-								Vector2 defPos = {(float)defPixel.x, (float)defPixel.y};
-								combatarcs::AttackArc attackArc = combatarcs::getAttackArc(atkPos, defPos, clickedUnit->facing);
+								combatarcs::AttackArc attackArc = combatarcs::getAttackArc(
+								    game.selectedUnit()->position, clickedUnit->position, clickedUnit->facing);
 								uipanel::showTargetPanel(game, clickedUnit, attackArc);
 
-								gamelogic::performAttack(game, game.selectedUnit, clickedUnit);
+								gamelogic::performAttack(game, game.selectedUnit(), clickedUnit);
 								rendering::clearSelectionHighlights(game);
-								game.selectedUnit = nullptr;
+								game.selected = UnitHandle();
 								game.movementSel.reset();
 								game.showAttackLines = false;
 								// Keep target panel visible after attack (don't hide it)
 								uipanel::hidePlayerPanel(game);
 							}
 						} else if (clickedUnit) {
-							game.selectedUnit = clickedUnit;
+							game.selected = clickedUnit->handle;
 							game.movementSel.reset();
 							rendering::clearSelectionHighlights(game);
 
 							// Only show movement/attack highlights and targeting lines for friendly units
 							if (clickedUnit->side == game.currentPlayer) {
 								if (!clickedUnit->hasMoved) {
-									gamelogic::highlightMovementRange(game, game.selectedUnit);
+									gamelogic::highlightMovementRange(game, game.selectedUnit());
 								}
-								gamelogic::highlightAttackRange(game, game.selectedUnit);
+								gamelogic::highlightAttackRange(game, game.selectedUnit());
 
 								// Update attack lines for selected unit
 								gamelogic::updateAttackLines(game);
@@ -280,18 +292,9 @@ int main() {
 							} else {
 								// Enemy unit selected - show target panel
 								// Calculate attack arc from current selected unit to this enemy
-								if (game.selectedUnit) {
-									Layout layout = rendering::createHexLayout(HEX_SIZE, game.camera.offsetX,
-									                                           game.camera.offsetY, game.camera.zoom);
-									OffsetCoord attackerOffset = rendering::gameCoordToOffset(game.selectedUnit->position);
-									OffsetCoord defenderOffset = rendering::gameCoordToOffset(clickedUnit->position);
-									::Hex attackerCube = OffsetToCube(attackerOffset);
-									::Hex defenderCube = OffsetToCube(defenderOffset);
-									Point attackerPixel = HexToPixel(layout, attackerCube);
-									Point defenderPixel = HexToPixel(layout, defenderCube);
-									Vector2 attackerPos = {(float)attackerPixel.x, (float)attackerPixel.y};
-									Vector2 defenderPos = {(float)defenderPixel.x, (float)defenderPixel.y};
-									combatarcs::AttackArc arc = combatarcs::getAttackArc(attackerPos, defenderPos, clickedUnit->facing);
+								if (game.selectedUnit()) {
+									combatarcs::AttackArc arc = combatarcs::getAttackArc(
+									    game.selectedUnit()->position, clickedUnit->position, clickedUnit->facing);
 									uipanel::showTargetPanel(game, clickedUnit, arc);
 								}
 								game.showAttackLines = false;
@@ -302,17 +305,17 @@ int main() {
 							uipanel::hideTargetPanel(game);
 							uipanel::hidePlayerPanel(game);
 						}
-					} else if (!game.selectedUnit) {
+					} else if (!game.selectedUnit()) {
 						if (clickedUnit) {
-							game.selectedUnit = clickedUnit;
+							game.selected = clickedUnit->handle;
 							game.movementSel.reset();
 
 							// Only show movement/attack highlights and targeting lines for friendly units
 							if (clickedUnit->side == game.currentPlayer) {
 								if (!clickedUnit->hasMoved) {
-									gamelogic::highlightMovementRange(game, game.selectedUnit);
+									gamelogic::highlightMovementRange(game, game.selectedUnit());
 								}
-								gamelogic::highlightAttackRange(game, game.selectedUnit);
+								gamelogic::highlightAttackRange(game, game.selectedUnit());
 
 								// Update attack lines for selected unit
 								gamelogic::updateAttackLines(game);
@@ -406,6 +409,10 @@ int main() {
 		// Update panel flash animations
 		paperdollui::updatePanelFlashes(game);
 
+		// Render any newly visible cached terrain tiles (must happen outside
+		// BeginDrawing)
+		rendering::updateTerrainCache(game);
+
 		// Drawing
 		BeginDrawing();
 		ClearBackground(kColorBackground);
@@ -432,6 +439,7 @@ int main() {
 		EndDrawing();
 	}
 
+	rendering::unloadTerrainCache(game);
 	CloseWindow();
 	return 0;
 }
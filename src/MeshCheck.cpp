@@ -0,0 +1,177 @@
+//==============================================================================
+// mesh-check - Checks the CPU-built terrain mesh against the hex layout
+//==============================================================================
+
+#include "Hex.hpp"
+#include "HexMap.hpp"
+#include "TerrainMesh.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr float kHexSize = 40.0f;
+constexpr float kGridWidth = 2.0f;
+constexpr double kTolerance = 1e-3; // Map-space pixels
+constexpr int kTerrainTypes = 10;
+
+const MeshColor kGrid = {1, 2, 3, 255};
+
+long failures = 0;
+
+void fail(const char* what, int rows, int cols, int hex) {
+	if (failures++ < 10)
+		std::printf("mismatch: %s (%dx%d map, hex %d)\n", what, rows, cols, hex);
+}
+
+// Edge midpoints snapped to an eighth of a pixel; distinct edges are
+// much further apart than that
+using EdgeKey = std::pair<long, long>;
+
+EdgeKey edgeKey(double x, double y) {
+	return {std::lround(x * 8.0), std::lround(y * 8.0)};
+}
+
+bool near(double a, double b) {
+	return std::fabs(a - b) < kTolerance;
+}
+
+void checkMap(int rows, int cols) {
+	HexMap map;
+	map.resize(rows, cols);
+	for (int i = 0; i < map.size(); i++) {
+		map.setTerrain(i, static_cast<TerrainType>(i % kTerrainTypes));
+	}
+
+	MeshColor palette[kTerrainTypes];
+	for (int i = 0; i < kTerrainTypes; i++) {
+		palette[i] = {(uint8_t)(10 * i), 0, 0, 255};
+	}
+
+	TerrainMesh mesh;
+	mesh.build(map, kHexSize, palette, kGrid, kGridWidth);
+	const std::vector<MeshVertex>& vertices = mesh.vertices();
+	const std::vector<uint32_t>& indices = mesh.indices();
+	int hexCount = map.size();
+	Layout layout(kLayoutPointy, Point(kHexSize, kHexSize), Point(0, 0));
+
+	// Every hex edge, keyed by its midpoint, with the lowest hex that has it
+	std::map<EdgeKey, int> owners;
+	for (int hex = 0; hex < hexCount; hex++) {
+		HexCoord coord = map.coord(hex);
+		CornerTable corners = HexCorners(layout, OffsetToCube(OffsetCoord(coord.col, coord.row)));
+		for (int i = 0; i < 6; i++) {
+			const Point& a = corners[i];
+			const Point& b = corners[(i + 1) % 6];
+			owners.emplace(edgeKey((a.x + b.x) * 0.5, (a.y + b.y) * 0.5), hex);
+		}
+	}
+	int edgeCount = (int)owners.size();
+
+	// Counts
+	if (mesh.fillIndexCount() != hexCount * TerrainMesh::kFillIndicesPerHex)
+		fail("fill index count", rows, cols, -1);
+	if (mesh.gridEdgeCount() != edgeCount)
+		fail("grid edge count", rows, cols, -1);
+	if ((int)vertices.size() != hexCount * TerrainMesh::kFillVerticesPerHex + edgeCount * TerrainMesh::kEdgeVertices)
+		fail("vertex count", rows, cols, -1);
+	if ((int)indices.size() != mesh.fillIndexCount() + edgeCount * TerrainMesh::kEdgeIndices)
+		fail("index count", rows, cols, -1);
+	if (mesh.gridBegin(0) != mesh.fillIndexCount() || mesh.gridBegin(hexCount) != (int)indices.size())
+		fail("grid range bounds", rows, cols, -1);
+	if (failures > 0)
+		return;
+
+	// Fill fans: center and corners where the layout puts them, in the
+	// hex's terrain color, using only the hex's own vertices
+	for (int hex = 0; hex < hexCount; hex++) {
+		HexCoord coord = map.coord(hex);
+		::Hex cube = OffsetToCube(OffsetCoord(coord.col, coord.row));
+		Point center = HexToPixel(layout, cube);
+		CornerTable corners = HexCorners(layout, cube);
+		int first = hex * TerrainMesh::kFillVerticesPerHex;
+
+		if (!near(vertices[first].x, center.x) || !near(vertices[first].y, center.y))
+			fail("fill center", rows, cols, hex);
+		for (int i = 0; i < 6; i++) {
+			const MeshVertex& v = vertices[first + 1 + i];
+			if (!near(v.x, corners[i].x) || !near(v.y, corners[i].y))
+				fail("fill corner", rows, cols, hex);
+		}
+		MeshColor color = palette[static_cast<int>(map.terrain(hex))];
+		for (int i = 0; i < TerrainMesh::kFillVerticesPerHex; i++) {
+			if (vertices[first + i].color.r != color.r)
+				fail("fill color", rows, cols, hex);
+		}
+		for (int i = mesh.fillBegin(hex); i < mesh.fillBegin(hex + 1); i++) {
+			if ((int)indices[i] < first || (int)indices[i] >= first + TerrainMesh::kFillVerticesPerHex)
+				fail("fill index outside its hex", rows, cols, hex);
+		}
+	}
+
+	// Grid quads: each edge once, in the range of the hex that owns it
+	std::map<EdgeKey, int> emitted;
+	for (int hex = 0; hex < hexCount; hex++) {
+		for (int i = mesh.gridBegin(hex); i < mesh.gridBegin(hex + 1); i += TerrainMesh::kEdgeIndices) {
+			// The quad's four vertices are consecutive; its midpoint is the edge's
+			uint32_t base = indices[i];
+			for (int k = 1; k < TerrainMesh::kEdgeIndices; k++) {
+				base = std::min(base, indices[i + k]);
+			}
+			double x = 0.0, y = 0.0;
+			for (int k = 0; k < TerrainMesh::kEdgeVertices; k++) {
+				x += vertices[base + k].x / (double)TerrainMesh::kEdgeVertices;
+				y += vertices[base + k].y / (double)TerrainMesh::kEdgeVertices;
+				if (vertices[base + k].color.r != kGrid.r || vertices[base + k].color.b != kGrid.b)
+					fail("grid color", rows, cols, hex);
+			}
+
+			EdgeKey key = edgeKey(x, y);
+			auto owner = owners.find(key);
+			if (owner == owners.end())
+				fail("grid quad not on a hex edge", rows, cols, hex);
+			else if (owner->second != hex)
+				fail("grid edge not owned by the lower-index hex", rows, cols, hex);
+			if (emitted[key]++ > 0)
+				fail("grid edge emitted twice", rows, cols, hex);
+		}
+	}
+	if ((int)emitted.size() != edgeCount)
+		fail("grid edges missing", rows, cols, -1);
+
+	// Winding: every triangle counter-clockwise on screen (negative cross
+	// product with y down), none degenerate
+	for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+		const MeshVertex& a = vertices[indices[i]];
+		const MeshVertex& b = vertices[indices[i + 1]];
+		const MeshVertex& c = vertices[indices[i + 2]];
+		float cross = (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+		if (!(cross < 0.0f))
+			fail("triangle winding", rows, cols, (int)(i / 3));
+	}
+
+	// Bounds cover every vertex
+	for (const MeshVertex& v : vertices) {
+		if (v.x < mesh.minX() || v.x > mesh.maxX() || v.y < mesh.minY() || v.y > mesh.maxY())
+			fail("bounds", rows, cols, -1);
+	}
+
+	std::printf("%dx%d map: %zu vertices, %d fill indices, %d grid edges\n", rows, cols, vertices.size(),
+	            mesh.fillIndexCount(), mesh.gridEdgeCount());
+}
+
+} // namespace
+
+int main() {
+	// Odd and even row and column counts, since odd-r rows are offset
+	checkMap(5, 6);
+	checkMap(4, 7);
+
+	std::printf("%ld mismatches\n", failures);
+	return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,153 @@
+#include "OddsEngine.hpp"
+
+#include <algorithm>
+#include "DamageSystem.hpp"
+#include "HitTables.hpp"
+
+namespace odds {
+
+AttackOdds::AttackOdds()
+    : hitChance(0.0), killChance(0.0), expectedDamage(0.0), destroyChance(), exact(true), samples(0) {
+}
+
+namespace {
+
+constexpr int kSampleBatch = 256;
+
+// Per-shot outcome probabilities
+constexpr double kMiss = hittables::kMissPercent / 100.0;
+constexpr double kCenter = (1.0 - kMiss) * (hittables::kCenterHitPercent / 100.0);
+constexpr double kArc = (1.0 - kMiss) - kCenter;
+
+bool isDead(const ArmorLocations& state) {
+	return state[ArmorLocation::CENTER].isDestroyed;
+}
+
+// Add one final outcome, with weight, to the totals
+void accumulate(AttackOdds& odds, const ArmorLocations& state, int absorbed, double weight) {
+	odds.expectedDamage += weight * absorbed;
+	if (isDead(state))
+		odds.killChance += weight;
+	for (int i = 0; i < kArmorLocationCount; i++) {
+		if (state[static_cast<ArmorLocation>(i)].isDestroyed)
+			odds.destroyChance[i] += weight;
+	}
+}
+
+struct Enumeration {
+	const std::vector<int>& shots;
+	ArmorLocation arcLocation;
+	AttackOdds& odds;
+
+	void visit(const ArmorLocations& state, int absorbed, size_t shot, double weight) {
+		// A dead target takes no more shots
+		if (shot == shots.size() || isDead(state)) {
+			accumulate(odds, state, absorbed, weight);
+			return;
+		}
+
+		visit(state, absorbed, shot + 1, weight * kMiss);
+
+		ArmorLocations center = state;
+		int centerAbsorbed = damagesystem::applyDamage(center, ArmorLocation::CENTER, shots[shot]);
+		visit(center, absorbed + centerAbsorbed, shot + 1, weight * kCenter);
+
+		ArmorLocations arc = state;
+		int arcAbsorbed = damagesystem::applyDamage(arc, arcLocation, shots[shot]);
+		visit(arc, absorbed + arcAbsorbed, shot + 1, weight * kArc);
+	}
+};
+
+// Samples run in batches: each shot's outcomes are drawn for the whole
+// batch, then applied per sample
+void sample(const ArmorLocations& target, ArmorLocation arcLocation, const std::vector<int>& shots, rng::Pcg32& rng,
+            AttackOdds& odds) {
+	std::vector<ArmorLocations> states(kSampleBatch);
+	std::vector<int> absorbed(kSampleBatch);
+	std::vector<ArmorLocation> hits(kSampleBatch);
+	double weight = 1.0 / kMonteCarloSamples;
+
+	for (int first = 0; first < kMonteCarloSamples; first += kSampleBatch) {
+		int count = std::min(kSampleBatch, kMonteCarloSamples - first);
+		std::fill(states.begin(), states.begin() + count, target);
+		std::fill(absorbed.begin(), absorbed.begin() + count, 0);
+
+		for (int damage : shots) {
+			// Same two rolls as performAttack and rollHitLocation
+			for (int i = 0; i < count; i++) {
+				if ((int)rng.below(100) < hittables::kMissPercent)
+					hits[i] = ArmorLocation::NONE;
+				else if ((int)rng.below(100) < hittables::kCenterHitPercent)
+					hits[i] = ArmorLocation::CENTER;
+				else
+					hits[i] = arcLocation;
+			}
+			for (int i = 0; i < count; i++) {
+				if (hits[i] != ArmorLocation::NONE && !isDead(states[i]))
+					absorbed[i] += damagesystem::applyDamage(states[i], hits[i], damage);
+			}
+		}
+
+		for (int i = 0; i < count; i++) {
+			accumulate(odds, states[i], absorbed[i], weight);
+		}
+	}
+}
+
+bool sameState(const ArmorLocations& a, const ArmorLocations& b) {
+	for (int i = 0; i < kArmorLocationCount; i++) {
+		const LocationStatus& x = a[static_cast<ArmorLocation>(i)];
+		const LocationStatus& y = b[static_cast<ArmorLocation>(i)];
+		if (x.currentArmor != y.currentArmor || x.currentStructure != y.currentStructure ||
+		    x.isDestroyed != y.isDestroyed)
+			return false;
+	}
+	return true;
+}
+
+} // namespace
+
+AttackOdds computeOdds(const ArmorLocations& target, combatarcs::AttackArc arc, const std::vector<int>& shots,
+                       rng::Pcg32& rng) {
+	AttackOdds odds;
+	ArmorLocation location = hittables::arcLocation(arc);
+
+	double allMiss = 1.0;
+	for (size_t i = 0; i < shots.size(); i++) {
+		allMiss *= kMiss;
+	}
+	odds.hitChance = 1.0 - allMiss;
+
+	if ((int)shots.size() <= kMaxExactShots) {
+		Enumeration enumeration {shots, location, odds};
+		enumeration.visit(target, 0, 0, 1.0);
+	} else {
+		odds.exact = false;
+		odds.samples = kMonteCarloSamples;
+		sample(target, location, shots, rng, odds);
+	}
+	return odds;
+}
+
+size_t OddsCache::KeyHash::operator()(const Key& key) const {
+	size_t hash = key.attacker.index;
+	hash = hash * 31 + key.attacker.generation;
+	hash = hash * 31 + key.target.index;
+	hash = hash * 31 + key.target.generation;
+	return hash * 4 + static_cast<size_t>(key.arc);
+}
+
+const AttackOdds& OddsCache::get(const Unit& attacker, const Unit& target, combatarcs::AttackArc arc) {
+	Key key {attacker.handle, target.handle, arc};
+	auto it = entries_.find(key);
+	if (it != entries_.end() && it->second.damage == attacker.attack && sameState(it->second.target, target.locations))
+		return it->second.odds;
+
+	Entry& entry = entries_[key];
+	entry.target = target.locations;
+	entry.damage = attacker.attack;
+	entry.odds = computeOdds(target.locations, arc, {attacker.attack}, sampler_);
+	return entry.odds;
+}
+
+} // namespace odds
@@ -101,11 +101,11 @@ void renderDiagonalStripes(Rectangle rect, Color stripeColor, int width) {
 // ============================================================================
 
 void renderBodySection(Rectangle rect, const Unit* unit, ArmorLocation location) {
-	if (unit->locations.find(location) == unit->locations.end()) {
+	if (!ArmorLocations::contains(location)) {
 		return;
 	}
 
-	const LocationStatus& loc = unit->locations.at(location);
+	const LocationStatus& loc = unit->locations[location];
 
 	// Determine state and color
 	bool isDestroyed = (loc.currentArmor == 0 && loc.currentStructure == 0);
@@ -180,7 +180,7 @@ void renderPaperdollLabels(const PaperdollPanel& panel) {
 // WEAPON LOADOUT
 // ============================================================================
 
-void renderWeaponLoadout(const PaperdollPanel& panel, const Unit* unit) {
+void renderWeaponLoadout(const PaperdollPanel& panel, const UnitDetails& details) {
 	float x = panel.bounds.x + panel.bounds.width - 150; // Right side
 	float y = panel.bounds.y + 30;
 
@@ -189,7 +189,7 @@ void renderWeaponLoadout(const PaperdollPanel& panel, const Unit* unit) {
 	DrawTextEx(cherrystyle::CHERRY_FONT, "LOADOUT", Vector2 {x, y}, (float)fontSize, spacing, GRAY);
 	y += 22;
 
-	for (const Weapon& weapon : unit->weapons) {
+	for (const Weapon& weapon : details.weapons) {
 		Color weaponColor = getWeaponColor(weapon.type);
 		if (weapon.isDestroyed) {
 			weaponColor = DISABLED_WEAPON_COLOR;
@@ -252,11 +252,11 @@ void renderPanelHeader(const PaperdollPanel& panel, const Unit* unit, [[maybe_un
 	int totalStructure = 0, currentStructure = 0;
 	int totalArmor = 0, currentArmor = 0;
 
-	for (const auto& loc : unit->locations) {
-		totalArmor += loc.second.maxArmor;
-		currentArmor += loc.second.currentArmor;
-		totalStructure += loc.second.maxStructure;
-		currentStructure += loc.second.currentStructure;
+	for (const LocationStatus& loc : unit->locations) {
+		totalArmor += loc.maxArmor;
+		currentArmor += loc.currentArmor;
+		totalStructure += loc.maxStructure;
+		currentStructure += loc.currentStructure;
 	}
 
 	DrawTextEx(cherrystyle::CHERRY_FONT, TextFormat("S: %d/%d", currentStructure, totalStructure),
@@ -291,11 +291,11 @@ void renderLocationTooltip(const PaperdollPanel& panel, const Unit* unit) {
 	if (panel.hoveredLocation == ArmorLocation::NONE)
 		return;
 
-	if (unit->locations.find(panel.hoveredLocation) == unit->locations.end()) {
+	if (!ArmorLocations::contains(panel.hoveredLocation)) {
 		return;
 	}
 
-	const LocationStatus& loc = unit->locations.at(panel.hoveredLocation);
+	const LocationStatus& loc = unit->locations[panel.hoveredLocation];
 
 	// Build tooltip text
 	std::string locationName = locationToString(panel.hoveredLocation);
@@ -336,11 +336,11 @@ void renderLocationTooltip(const PaperdollPanel& panel, const Unit* unit) {
 // ============================================================================
 
 void renderTargetPanel(const GameState& game) {
-	if (!game.targetPanel.isVisible || !game.targetPanel.targetUnit)
+	const Unit* unit = game.units.get(game.targetPanel.targetUnit);
+	if (!game.targetPanel.isVisible || !unit)
 		return;
 
 	const TargetPanel& panel = game.targetPanel;
-	Unit* unit = panel.targetUnit;
 
 	// 1. Draw panel background
 	Color backgroundColor = GetColor(GuiGetStyle(DROPDOWNBOX, BASE_COLOR_NORMAL));
@@ -359,7 +359,7 @@ void renderTargetPanel(const GameState& game) {
 	renderFlashOverlay(panel);
 
 	// 5. Draw weapon loadout list
-	renderWeaponLoadout(panel, unit);
+	renderWeaponLoadout(panel, game.units.details(*unit));
 
 	// 6. Draw tooltip if hovering over body part
 	if (panel.showTooltip) {
@@ -368,11 +368,11 @@ void renderTargetPanel(const GameState& game) {
 }
 
 void renderPlayerPanel(const GameState& game) {
-	if (!game.playerPanel.isVisible || !game.playerPanel.playerUnit)
+	const Unit* unit = game.units.get(game.playerPanel.playerUnit);
+	if (!game.playerPanel.isVisible || !unit)
 		return;
 
 	const PlayerPanel& panel = game.playerPanel;
-	Unit* unit = panel.playerUnit;
 
 	// 1. Draw panel background
 	Color backgroundColor = GetColor(GuiGetStyle(DROPDOWNBOX, BASE_COLOR_NORMAL));
@@ -537,16 +537,21 @@ void renderFlashOverlay(const PaperdollPanel& panel) {
 
 void triggerHitFlash(GameState& game, Unit* unit, ArmorLocation location) {
 	// Check if unit matches target panel
-	if (game.targetPanel.isVisible && game.targetPanel.targetUnit == unit) {
+	if (game.targetPanel.isVisible && game.targetPanel.targetUnit == unit->handle) {
 		game.targetPanel.startFlash(location);
 	}
 
 	// Check if unit matches player panel
-	if (game.playerPanel.isVisible && game.playerPanel.playerUnit == unit) {
+	if (game.playerPanel.isVisible && game.playerPanel.playerUnit == unit->handle) {
 		game.playerPanel.startFlash(location);
 	}
 }
 
+void flashCombatEvent(GameState& game, const combatevents::CombatEvent& event) {
+	if (event.type == combatevents::CombatEventType::LOCATION_HIT)
+		triggerHitFlash(game, event.defender, event.location);
+}
+
 void updatePanelFlashes(GameState& game) {
 	game.targetPanel.updateFlash();
 	game.playerPanel.updateFlash();
@@ -0,0 +1,57 @@
+#include "PathEngine.hpp"
+
+#include <algorithm>
+
+namespace pathengine {
+
+PathEngine::PathEngine()
+    : topology_(nullptr), rows_(0), cols_(0), generation_(0) {
+}
+
+void PathEngine::setTopology(const HexTopology& topology) {
+	topology_ = &topology;
+	int rows = topology.rows();
+	int cols = topology.cols();
+	if (rows == rows_ && cols == cols_)
+		return;
+
+	rows_ = rows;
+	cols_ = cols;
+	size_t count = (size_t)rows * (size_t)cols;
+	cost_.assign(count, 0);
+	parent_.assign(count, -1);
+	seen_.assign(count, 0);
+	closed_.assign(count, 0);
+	generation_ = 0;
+}
+
+void PathEngine::beginSearch() {
+	heap_.clear();
+	settled_.clear();
+
+	// Stamps wrapped around: old entries could alias the new generation
+	if (++generation_ == 0) {
+		std::fill(seen_.begin(), seen_.end(), 0);
+		std::fill(closed_.begin(), closed_.end(), 0);
+		generation_ = 1;
+	}
+}
+
+void PathEngine::pathTo(int goal, std::vector<HexCoord>& out) const {
+	out.clear();
+	if (!reached(goal))
+		return;
+
+	for (int index = goal; index >= 0; index = parent_[index]) {
+		out.push_back(coord(index));
+	}
+	std::reverse(out.begin(), out.end());
+}
+
+std::vector<HexCoord> PathEngine::pathTo(int goal) const {
+	std::vector<HexCoord> path;
+	pathTo(goal, path);
+	return path;
+}
+
+} // namespace pathengine
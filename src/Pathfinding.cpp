@@ -2,201 +2,85 @@
 #include <string>
 #include "Constants.hpp"
 #include "GameLogic.hpp"
-
-// Forward declaration for Rendering function
-namespace rendering {
-void clearSelectionHighlights(GameState &game);
-}
+#include "PathEngine.hpp"
 
 namespace gamelogic {
 
-// BFS pathfinding - returns path from start to goal
+// A* pathfinding - returns path from start to goal (empty if unreachable)
 std::vector<HexCoord> findPath(GameState &game, Unit *unit, const HexCoord &start, const HexCoord &goal) {
 	if (!unit)
 		return {};
 	if (start == goal)
 		return {start};
 
-	int movMethodIdx = static_cast<int>(unit->movMethod);
+	pathengine::PathEngine &engine = game.pathEngine;
+	engine.setTopology(game.map.topology());
+	if (!engine.inBounds(start) || !engine.inBounds(goal))
+		return {};
+
+	const int *movCosts = kMovTableDry[static_cast<int>(unit->movMethod)];
+	int goalIndex = engine.index(goal);
+
+	auto enterCost = [&](int, int next) {
+		HexCoord coord = engine.coord(next);
+		int cost = movCosts[getTerrainIndex(game.map.terrain(next))];
+		if (cost >= pathengine::kNoEntryCost)
+			return cost;
 
-	// BFS with parent tracking
-	struct PathNode {
-		HexCoord coord;
-		int movementUsed; // Total movement used to reach this node
-		HexCoord parent;
-		bool hasParent;
+		// Occupied hexes block, except an enemy on the goal (for attacking)
+		Unit *occupant = game.getUnitAt(coord);
+		if (occupant && !(next == goalIndex && occupant->side != unit->side))
+			return pathengine::kNoEntryCost;
+		return cost;
 	};
 
-	std::vector<PathNode> queue;
-	std::vector<PathNode> visited;
-
-	// Start node
-	queue.push_back({start, 0, {-1, -1}, false});
-	visited.push_back({start, 0, {-1, -1}, false});
-
-	while (!queue.empty()) {
-		PathNode current = queue.front();
-		queue.erase(queue.begin()); // Remove first element
-
-		// Check if we reached the goal
-		if (current.coord == goal) {
-			// Reconstruct path
-			std::vector<HexCoord> path;
-			HexCoord c = goal;
-
-			while (true) {
-				path.push_back(c);
-				bool found = false;
-				for (const auto &v : visited) {
-					if (v.coord == c && v.hasParent) {
-						c = v.parent;
-						found = true;
-						break;
-					}
-				}
-				if (!found)
-					break;
-				if (c == start) {
-					path.push_back(start);
-					break;
-				}
-			}
-
-			// Reverse path so it goes from start to goal
-			std::reverse(path.begin(), path.end());
-			return path;
-		}
+	if (!engine.findPath(engine.index(start), goalIndex, unit->movesLeft, enterCost))
+		return {};
+	return engine.pathTo(goalIndex);
+}
 
-		// Explore neighbors
-		std::vector<HexCoord> adjacent = getAdjacent(current.coord.row, current.coord.col);
-
-		for (const auto &adj : adjacent) {
-			// Get terrain cost
-			GameHex &hex = game.map[adj.row][adj.col];
-			int terrainIdx = getTerrainIndex(hex.terrain);
-			int cost = kMovTableDry[movMethodIdx][terrainIdx];
-
-			// Skip impassable terrain
-			if (cost >= 255)
-				continue;
-
-			int newMovementUsed = current.movementUsed + cost;
-
-			// For cost 254, it stops movement
-			if (cost == 254)
-				newMovementUsed = 999; // Very high cost
-
-			// Check if we can afford this movement
-			if (newMovementUsed > unit->movesLeft * 2)
-				continue; // Allow some extra for pathfinding flexibility
-
-			// Check if another unit occupies this hex
-			// Allow only if it's the goal and it's an enemy (for attacking)
-			Unit *occupant = game.getUnitAt(adj);
-			if (occupant && !(adj == goal && occupant->side != unit->side))
-				continue;
-
-			// Check if we've already visited this with lower cost
-			bool alreadyVisited = false;
-			for (const auto &v : visited) {
-				if (v.coord == adj && v.movementUsed <= newMovementUsed) {
-					alreadyVisited = true;
-					break;
-				}
-			}
-
-			if (!alreadyVisited) {
-				PathNode newNode = {adj, newMovementUsed, current.coord, true};
-				queue.push_back(newNode);
-				visited.push_back(newNode);
-			}
-		}
+const ReachabilityField &getReachability(GameState &game, const Unit *unit) {
+	ReachabilityField &field = game.reachability;
+	if (!unit) {
+		field.invalidate();
+		return field;
 	}
 
-	// No path found
-	return {};
+	// Reuse the cached flood while nothing it depends on has changed
+	if (field.valid && field.unit == unit->handle && field.origin == unit->position && field.movesLeft == unit->movesLeft && field.terrainRevision == game.map.terrainRevision() && field.occupancyRevision == game.occupancyRevision)
+		return field;
+
+	pathengine::PathEngine &engine = field.search;
+	engine.setTopology(game.map.topology());
+
+	const int *movCosts = kMovTableDry[static_cast<int>(unit->movMethod)];
+	auto enterCost = [&](int, int next) {
+		HexCoord coord = engine.coord(next);
+		// Block all occupied hexes, not just enemies
+		if (game.getUnitAt(coord))
+			return pathengine::kNoEntryCost;
+		return movCosts[getTerrainIndex(game.map.terrain(next))];
+	};
+	engine.flood(engine.index(unit->position), unit->movesLeft, enterCost);
+
+	field.unit = unit->handle;
+	field.origin = unit->position;
+	field.movesLeft = unit->movesLeft;
+	field.terrainRevision = game.map.terrainRevision();
+	field.occupancyRevision = game.occupancyRevision;
+	field.valid = true;
+	return field;
 }
 
 void highlightMovementRange(GameState &game, Unit *unit) {
-	rendering::clearSelectionHighlights(game);
+	game.map.clearSelection();
 	if (!unit)
 		return;
 
-	int maxRange = unit->movesLeft;
-	int movMethodIdx = static_cast<int>(unit->movMethod);
-
-	// Track cells we can reach with their remaining movement
-	std::vector<std::pair<HexCoord, int>> frontier;
-	std::vector<std::pair<HexCoord, int>> visited;
-
-	// Start with unit's position
-	frontier.push_back({unit->position, maxRange});
-	visited.push_back({unit->position, maxRange});
-
-	while (!frontier.empty()) {
-		auto current = frontier.back();
-		frontier.pop_back();
-
-		HexCoord pos = current.first;
-		int remainingMoves = current.second;
-
-		// Check all adjacent hexes
-		std::vector<HexCoord> adjacent = getAdjacent(pos.row, pos.col);
-
-		for (const auto &adj : adjacent) {
-			// Get terrain cost
-			GameHex &hex = game.map[adj.row][adj.col];
-			int terrainIdx = getTerrainIndex(hex.terrain);
-			int cost = kMovTableDry[movMethodIdx][terrainIdx];
-
-			// Skip impassable terrain
-			if (cost >= 255)
-				continue;
-
-			// Check if we can enter this hex
-			int newRemaining = remainingMoves - cost;
-
-			// For cost 254, we can enter but it stops us (remaining becomes 0)
-			if (cost == 254)
-				newRemaining = 0;
-
-			// Skip if we can't afford to enter
-			if (newRemaining < 0)
-				continue;
-
-			// Check if another unit occupies this hex (block all units, not just enemies)
-			Unit *occupant = game.getUnitAt(adj);
-			if (occupant)
-				continue;
-
-			// Check if we've already visited with more movement
-			bool shouldUpdate = true;
-			bool alreadyVisited = false;
-			for (auto &v : visited) {
-				if (v.first == adj) {
-					alreadyVisited = true;
-					if (v.second >= newRemaining) {
-						shouldUpdate = false;
-					} else {
-						v.second = newRemaining;
-					}
-					break;
-				}
-			}
-
-			if (!alreadyVisited) {
-				visited.push_back({adj, newRemaining});
-			}
-
-			if (shouldUpdate && newRemaining > 0) {
-				frontier.push_back({adj, newRemaining});
-			}
-		}
-	}
-
 	// Highlight all reachable cells (including starting position)
-	for (const auto &v : visited) {
-		game.map[v.first.row][v.first.col].isMoveSel = true;
+	const ReachabilityField &field = getReachability(game, unit);
+	for (int index : field.search.settled()) {
+		game.map.moveSel().set(index);
 	}
 }
 
@@ -206,64 +90,124 @@ void highlightAttackRange(GameState &game, Unit *unit) {
 
 	int range = unit->weaponRange; // Use unit's weapon range
 
-	for (int row = 0; row < MAP_ROWS; row++) {
-		for (int col = 0; col < MAP_COLS; col++) {
-			HexCoord target = {row, col};
-			int dist = hexDistance(unit->position, target);
-
-			if (dist > 0 && dist <= range) {
-				Unit *occupant = game.getUnitAt(target);
-				if (occupant && occupant->side != unit->side) {
-					game.map[row][col].isAttackSel = true;
-				}
-			}
+	std::vector<HexCoord> cells;
+	getCellsInRange(unit->position.row, unit->position.col, range, cells);
+
+	for (const auto &target : cells) {
+		Unit *occupant = game.getUnitAt(target);
+		if (occupant && occupant->side != unit->side) {
+			game.map.attackSel().set(game.map.index(target));
 		}
 	}
 }
 
+// Move the unit's spotting to its position. Spotting an enemy can't be
+// taken back, so it also ends undo for the moves made so far.
+static void updateMoverSight(GameState &game, Unit *unit) {
+	size_t seen = game.visibilityChanges.size();
+	updateUnitSight(game, unit);
+
+	for (size_t i = seen; i < game.visibilityChanges.size(); i++) {
+		const VisibilityChange &change = game.visibilityChanges[i];
+		Unit *spotted = change.visible && change.side == unit->side ? game.getUnitAt(change.hex) : nullptr;
+		if (spotted && spotted->side != unit->side) {
+			game.moveHistory.clear();
+			return;
+		}
+	}
+}
+
+int enterCost(const Unit &unit, int terrainIndex) {
+	int cost = kMovTableDry[static_cast<int>(unit.movMethod)][terrainIndex];
+	// For difficult terrain (cost 254), we can enter but it uses all remaining moves
+	if (cost == 254)
+		cost = unit.movesLeft;
+	return cost;
+}
+
 void moveUnit(GameState &game, Unit *unit, const HexCoord &target, bool updateSpotting) {
 	if (!unit)
 		return;
 
 	// Calculate actual movement cost based on terrain
-	int movMethodIdx = static_cast<int>(unit->movMethod);
-	GameHex &targetHex = game.map[target.row][target.col];
-	int terrainIdx = getTerrainIndex(targetHex.terrain);
-	int cost = kMovTableDry[movMethodIdx][terrainIdx];
+	int cost = enterCost(*unit, getTerrainIndex(game.map.terrain(target)));
 
 	// Don't move if impassable
 	if (cost >= 255) {
-		addLogMessage(game, "Terrain is impassable");
+		addLogMessage(game, combatlog::LogTemplate::IMPASSABLE);
 		return;
 	}
 
-	// For difficult terrain (cost 254), we can enter but it uses all remaining moves
-	if (cost == 254)
-		cost = unit->movesLeft;
-
 	// Only move if we have enough movement points
 	if (cost <= unit->movesLeft) {
-		// Clear spotting from old position
-		if (updateSpotting) {
-			setUnitSpotRange(game, unit, false);
-		}
+		MoveRecord record {unit->handle, unit->position, target, unit->movesLeft, 0, unit->hasMoved, unit->facing, unit->facing};
+		game.moveHistory.push(record);
 
 		// Move unit
-		unit->position = target;
+		game.relocateUnit(unit, target);
 		unit->movesLeft = 0; // One move per turn - all movement used up
 		unit->hasMoved = true;
 
-		// Set spotting at new position
+		// Move spotting to the new position
 		if (updateSpotting) {
-			setUnitSpotRange(game, unit, true);
+			updateMoverSight(game, unit);
 		}
 
 		// Log movement
-		std::string unitName = unit->name + " (" + (unit->side == 0 ? "Axis" : "Allied") + ")";
-		addLogMessage(game, unitName + " moves to (" + std::to_string(target.row) + "," + std::to_string(target.col) + ")");
+		addLogMessage(game, combatlog::LogTemplate::UNIT_MOVES, {game.units.details(*unit).name, unit->side == 0 ? "Axis" : "Allied", target.row, target.col});
 	} else {
-		addLogMessage(game, "Not enough movement points");
+		addLogMessage(game, combatlog::LogTemplate::NOT_ENOUGH_MOVES);
+	}
+}
+
+void confirmMove(GameState &game, Unit *unit, float facing) {
+	if (!unit)
+		return;
+
+	unit->facing = facing;
+	MoveRecord *last = game.moveHistory.last();
+	if (last && last->unit == unit->handle)
+		last->facingAfter = facing;
+	updateMoverSight(game, unit);
+}
+
+Unit *undoMove(GameState &game) {
+	const MoveRecord *record = game.moveHistory.undo();
+	if (!record)
+		return nullptr;
+
+	Unit *unit = game.units.get(record->unit);
+	Unit *occupant = game.getUnitAt(record->from);
+	if (!unit || !(unit->position == record->to) || (occupant && occupant != unit)) {
+		game.moveHistory.clear();
+		return nullptr;
 	}
+
+	game.relocateUnit(unit, record->from);
+	unit->movesLeft = record->movesLeftBefore;
+	unit->hasMoved = record->hasMovedBefore;
+	unit->facing = record->facingBefore;
+	updateUnitSight(game, unit);
+	return unit;
+}
+
+Unit *redoMove(GameState &game) {
+	const MoveRecord *record = game.moveHistory.redo();
+	if (!record)
+		return nullptr;
+
+	Unit *unit = game.units.get(record->unit);
+	if (!unit || !(unit->position == record->from) || game.getUnitAt(record->to)) {
+		game.moveHistory.clear();
+		return nullptr;
+	}
+
+	game.relocateUnit(unit, record->to);
+	unit->movesLeft = record->movesLeftAfter;
+	unit->hasMoved = true;
+	unit->facing = record->facingAfter;
+	updateMoverSight(game, unit);
+	return unit;
 }
 
 } // namespace gamelogic
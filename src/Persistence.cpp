@@ -23,6 +23,8 @@ void saveConfig(const VideoSettings& settings) {
 	configFile << "combatTextFadeInTime=" << settings.combatTextFadeInTime << "\n";
 	configFile << "combatTextFloatTime=" << settings.combatTextFloatTime << "\n";
 	configFile << "combatTextFloatSpeed=" << settings.combatTextFloatSpeed << "\n";
+	configFile << "aiOpponent=" << (settings.aiOpponent ? 1 : 0) << "\n";
+	configFile << "aiTurnBudgetMs=" << settings.aiTurnBudgetMs << "\n";
 
 	configFile.close();
 	TraceLog(LOG_INFO, "Config saved to config.txt");
@@ -85,6 +87,13 @@ void loadConfig(VideoSettings& settings) {
 				if (val >= 1.0f && val <= 200.0f) {
 					settings.combatTextFloatSpeed = val;
 				}
+			} else if (key == "aiOpponent") {
+				settings.aiOpponent = (std::stoi(value) != 0);
+			} else if (key == "aiTurnBudgetMs") {
+				int val = std::stoi(value);
+				if (val >= 0 && val <= 60000) {
+					settings.aiTurnBudgetMs = val;
+				}
 			} else if (key == "panSpeed") {
 				// Deprecated: panSpeed is now hardcoded to 1.0f
 				// Keep this for backwards compatibility with old config files
@@ -0,0 +1,121 @@
+#include "Random.hpp"
+
+namespace rng {
+
+static constexpr uint64_t kMultiplier = 6364136223846793005ULL;
+
+Pcg32::Pcg32() {
+	seed(kDefaultSeed, 0);
+}
+
+Pcg32::Pcg32(uint64_t seed_, uint64_t stream) {
+	seed(seed_, stream);
+}
+
+void Pcg32::seed(uint64_t seed_, uint64_t stream) {
+	state_.state = 0;
+	state_.inc = (stream << 1) | 1;
+	next();
+	state_.state += seed_;
+	next();
+}
+
+uint32_t Pcg32::next() {
+	uint64_t old = state_.state;
+	state_.state = old * kMultiplier + state_.inc;
+	uint32_t xorshifted = (uint32_t)(((old >> 18) ^ old) >> 27);
+	uint32_t rot = (uint32_t)(old >> 59);
+	return (xorshifted >> rot) | (xorshifted << ((32 - rot) & 31));
+}
+
+uint32_t Pcg32::below(uint32_t bound) {
+	if (bound == 0)
+		return 0;
+
+	// Reject the low values that would make some results more likely
+	uint32_t threshold = (0u - bound) % bound;
+	for (;;) {
+		uint32_t value = next();
+		if (value >= threshold)
+			return value % bound;
+	}
+}
+
+float Pcg32::unit() {
+	// 24 bits: every result is exactly representable and below 1
+	return (float)(next() >> 8) * (1.0f / 16777216.0f);
+}
+
+RandomService::RandomService(uint64_t seed) {
+	reseed(seed);
+}
+
+void RandomService::reseed(uint64_t seed) {
+	seed_ = seed;
+	for (int i = 0; i < static_cast<int>(Stream::COUNT); i++) {
+		streams_[i].seed(seed, (uint64_t)i);
+	}
+}
+
+Pcg32 RandomService::workerStream(uint32_t worker) const {
+	// Stream ids after the game's own purposes
+	return Pcg32(seed_, static_cast<uint64_t>(Stream::COUNT) + worker);
+}
+
+RandomService::Snapshot RandomService::snapshot() const {
+	Snapshot snapshot;
+	snapshot.seed = seed_;
+	for (int i = 0; i < static_cast<int>(Stream::COUNT); i++) {
+		snapshot.streams[i] = streams_[i].state();
+	}
+	return snapshot;
+}
+
+void RandomService::restore(const Snapshot& snapshot) {
+	seed_ = snapshot.seed;
+	for (int i = 0; i < static_cast<int>(Stream::COUNT); i++) {
+		streams_[i].setState(snapshot.streams[i]);
+	}
+}
+
+static void writeU64(std::vector<uint8_t>& out, uint64_t value) {
+	for (int i = 0; i < 8; i++) {
+		out.push_back((uint8_t)(value >> (8 * i)));
+	}
+}
+
+static uint64_t readU64(const uint8_t* data) {
+	uint64_t value = 0;
+	for (int i = 0; i < 8; i++) {
+		value |= (uint64_t)data[i] << (8 * i);
+	}
+	return value;
+}
+
+void RandomService::serialize(std::vector<uint8_t>& out) const {
+	Snapshot state = snapshot();
+	out.reserve(out.size() + kSerializedSize);
+	writeU64(out, state.seed);
+	for (const Pcg32::State& stream : state.streams) {
+		writeU64(out, stream.state);
+		writeU64(out, stream.inc);
+	}
+}
+
+bool RandomService::deserialize(const uint8_t* data, size_t size) {
+	if (size < kSerializedSize)
+		return false;
+
+	Snapshot state;
+	state.seed = readU64(data);
+	data += 8;
+	for (Pcg32::State& stream : state.streams) {
+		stream.state = readU64(data);
+		stream.inc = readU64(data + 8);
+		data += 16;
+	}
+	restore(state);
+	return true;
+}
+
+} // namespace rng
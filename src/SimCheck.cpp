@@ -0,0 +1,219 @@
+//==============================================================================
+// sim-check - Replays games on GameState and sim::SimState and compares them
+//==============================================================================
+
+#include "AiPlayer.hpp"
+#include "CombatArcs.hpp"
+#include "GameLogic.hpp"
+#include "SimState.hpp"
+#include "ThreadPool.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace {
+
+constexpr uint64_t kGames = 40;
+constexpr int kTurns = 16;
+constexpr int kBranchMs = 500; // How long the rollback check runs
+
+long failures = 0;
+
+void fail(const char* what, uint64_t seed) {
+	if (failures++ < 10)
+		std::printf("mismatch: %s (seed %llu)\n", what, (unsigned long long)seed);
+}
+
+bool sameUnit(const Unit& a, const Unit& b) {
+	if (!(a.position == b.position) || a.movesLeft != b.movesLeft || a.hasMoved != b.hasMoved ||
+	    a.hasFired != b.hasFired || a.facing != b.facing)
+		return false;
+	for (int i = 0; i < kArmorLocationCount; i++) {
+		ArmorLocation location = static_cast<ArmorLocation>(i);
+		if (a.locations.at(location).currentArmor != b.locations.at(location).currentArmor ||
+		    a.locations.at(location).currentStructure != b.locations.at(location).currentStructure)
+			return false;
+	}
+	return true;
+}
+
+void deploy(GameState& game) {
+	game.addUnit(UnitClass::LIGHT, 0, 4, 4);
+	game.addUnit(UnitClass::MEDIUM, 0, 4, 5);
+	game.addUnit(UnitClass::HEAVY, 0, 3, 4);
+	game.addUnit(UnitClass::LIGHT, 1, 6, 7);
+	game.addUnit(UnitClass::MEDIUM, 1, 7, 7);
+	game.addUnit(UnitClass::ASSAULT, 1, 6, 8);
+	gamelogic::initializeAllSpotting(game);
+}
+
+// Units, occupancy, spotting, turn and player of state against game
+void compare(GameState& game, const sim::SimState& state, uint64_t seed) {
+	for (Unit* unit : game.units) {
+		int index = state.find(unit->handle);
+		if (index < 0 || !sameUnit(*unit, state.unit(index)))
+			fail("unit", seed);
+	}
+	for (int i = 0; i < game.map.size(); i++) {
+		HexCoord coord = game.map.coord(i);
+		Unit* occupant = game.getUnitAt(coord);
+		if ((occupant ? state.find(occupant->handle) : -1) != state.unitAt(coord))
+			fail("occupancy", seed);
+		for (int side = 0; side < 2; side++) {
+			if (game.isSpotted(side, coord) != state.isSpotted(side, coord))
+				fail("spotting", seed);
+		}
+	}
+	if (game.currentTurn != state.currentTurn() || game.currentPlayer != state.currentPlayer())
+		fail("turn", seed);
+}
+
+Unit* nearestEnemy(GameState& game, const Unit* unit) {
+	Unit* nearest = nullptr;
+	for (Unit* other : game.units) {
+		if (other->side == unit->side || !other->isAlive())
+			continue;
+		if (!nearest || gamelogic::hexDistance(unit->position, other->position) <
+		                    gamelogic::hexDistance(unit->position, nearest->position))
+			nearest = other;
+	}
+	return nearest;
+}
+
+// Every unit closes on its nearest enemy, faces it and fires when in
+// range; each action is made on both states
+void replayGame(uint64_t seed) {
+	GameState game(seed);
+	deploy(game);
+	sim::SimState state(game);
+
+	for (int turn = 0; turn < kTurns; turn++) {
+		for (Unit* unit : game.units) {
+			if (unit->side != game.currentPlayer || !unit->isAlive())
+				continue;
+			Unit* enemy = nearestEnemy(game, unit);
+			if (!enemy)
+				break;
+			int self = state.find(unit->handle);
+
+			const pathengine::PathEngine& search = gamelogic::getReachability(game, unit).search;
+			int best = -1;
+			int bestDistance = gamelogic::hexDistance(unit->position, enemy->position);
+			bool closeIn = bestDistance > unit->weaponRange;
+			for (int index : search.settled()) {
+				int distance = gamelogic::hexDistance(search.coord(index), enemy->position);
+				if (distance < bestDistance) {
+					best = index;
+					bestDistance = distance;
+				}
+			}
+			if (closeIn && best >= 0) {
+				HexCoord target = search.coord(best);
+				gamelogic::moveUnit(game, unit, target);
+				if (!state.moveUnit(self, target))
+					fail("move refused", seed);
+			}
+
+			unit->facing = combatarcs::facingToward(unit->position, enemy->position);
+			state.setFacing(self, unit->facing);
+			if (gamelogic::hexDistance(unit->position, enemy->position) <= unit->weaponRange) {
+				gamelogic::performAttack(game, unit, enemy);
+				state.attack(self, state.find(enemy->handle));
+			}
+		}
+		gamelogic::endTurn(game);
+		state.endTurn();
+	}
+	compare(game, state, seed);
+}
+
+// Random branches rolled back to where they started leave no trace; prints
+// the branch rate
+void checkRollback() {
+	const uint64_t seed = 7;
+	GameState game(seed);
+	deploy(game);
+	sim::SimState state(game);
+	sim::SimState reference = state;
+
+	rng::Pcg32 random(seed, 1);
+	long branches = 0;
+	auto start = std::chrono::steady_clock::now();
+	while (std::chrono::steady_clock::now() - start < std::chrono::milliseconds(kBranchMs)) {
+		sim::SimState::Checkpoint checkpoint = state.checkpoint();
+		for (int action = 0; action < 6; action++) {
+			int unit = (int)random.below(state.unitCount());
+			const HexCoord& from = state.unit(unit).position;
+			HexCoord to {from.row + (int)random.below(3) - 1, from.col + (int)random.below(3) - 1};
+			state.moveUnit(unit, to);
+			state.setFacing(unit, (float)random.below(360));
+			state.attack(unit, (int)random.below(state.unitCount()));
+			if (action == 3)
+				state.endTurn();
+		}
+		state.rollback(checkpoint);
+		branches++;
+	}
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	for (int i = 0; i < state.unitCount(); i++) {
+		if (!sameUnit(state.unit(i), reference.unit(i)))
+			fail("unit after rollback", seed);
+	}
+	for (int i = 0; i < game.map.size(); i++) {
+		HexCoord coord = game.map.coord(i);
+		if (state.unitAt(coord) != reference.unitAt(coord))
+			fail("occupancy after rollback", seed);
+		for (int side = 0; side < 2; side++) {
+			if (state.isSpotted(side, coord) != reference.isSpotted(side, coord))
+				fail("spotting after rollback", seed);
+		}
+	}
+	rng::RandomService::Snapshot after = state.checkpoint().random;
+	rng::RandomService::Snapshot before = reference.checkpoint().random;
+	if (std::memcmp(&after, &before, sizeof(after)) != 0)
+		fail("RNG after rollback", seed);
+	if (state.journalSize() != 0)
+		fail("journal after rollback", seed);
+
+	std::printf("%ld checkpoint/six-action/rollback branches in %.2fs (%.0f per second)\n", branches, seconds,
+	            branches / seconds);
+}
+
+// The lookahead must leave the snapshot's state as it found it: the same
+// snapshot plans the same turn inline and on a pool
+void checkPlanning() {
+	ThreadPool pool(4);
+	for (uint64_t seed = 1; seed <= 10; seed++) {
+		GameState game(seed);
+		deploy(game);
+		gamelogic::endTurn(game);
+		ai::Snapshot snapshot = ai::takeSnapshot(game, 1);
+
+		ai::TurnPlan serial = ai::planTurn(snapshot, nullptr, 0);
+		ai::TurnPlan pooled = ai::planTurn(snapshot, &pool, 0);
+		bool same = serial.orders.size() == pooled.orders.size();
+		for (size_t i = 0; same && i < serial.orders.size(); i++) {
+			const ai::UnitOrder& a = serial.orders[i];
+			const ai::UnitOrder& b = pooled.orders[i];
+			same = a.unit == b.unit && a.moveTo == b.moveTo && a.facing == b.facing && a.target == b.target &&
+			       a.score == b.score;
+		}
+		if (!same)
+			fail("plan inline against pooled", seed);
+	}
+}
+
+} // namespace
+
+int main() {
+	for (uint64_t seed = 1; seed <= kGames; seed++) {
+		replayGame(seed);
+	}
+	checkRollback();
+	checkPlanning();
+
+	std::printf("%llu games of %d turns replayed, %ld mismatches\n", (unsigned long long)kGames, kTurns, failures);
+	return failures == 0 ? 0 : 1;
+}
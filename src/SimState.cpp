@@ -0,0 +1,180 @@
+#include "SimState.hpp"
+
+#include "CombatArcs.hpp"
+#include "DamageSystem.hpp"
+#include "GameLogic.hpp"
+#include "HitTables.hpp"
+
+namespace sim {
+
+SimState::SimState(GameState& game)
+    : rows_(game.map.rows()), cols_(game.map.cols()), random_(game.random), currentTurn_(game.currentTurn),
+      currentPlayer_(game.currentPlayer) {
+	gamelogic::syncSightTerrain(game);
+	sight_ = game.sight;
+
+	int count = game.map.size();
+	occupancy_.assign(count, -1);
+	terrain_.resize(count);
+	for (int i = 0; i < count; i++) {
+		terrain_[i] = (uint8_t)gamelogic::getTerrainIndex(game.map.terrain(i));
+	}
+	spotting_[0].resize(count);
+	spotting_[1].resize(count);
+
+	for (const Unit* unit : game.units) {
+		units_.push_back(*unit);
+	}
+	for (int i = 0; i < (int)units_.size(); i++) {
+		if (units_[i].isAlive()) {
+			occupancy_[index(units_[i].position)] = i;
+			setSpotting(i, true);
+		}
+	}
+	spotLog_.clear();
+}
+
+int SimState::find(UnitHandle handle) const {
+	for (int i = 0; i < (int)units_.size(); i++) {
+		if (units_[i].handle == handle)
+			return i;
+	}
+	return -1;
+}
+
+Unit& SimState::edit(int unit) {
+	unitLog_.push_back({unit, units_[unit]});
+	return units_[unit];
+}
+
+void SimState::setOccupant(int index, int unit) {
+	occupancyLog_.push_back({index, occupancy_[index]});
+	occupancy_[index] = unit;
+}
+
+void SimState::setSpotting(int unit, bool on) {
+	const Unit& spotter = units_[unit];
+	visibility::VisibilityLayer& layer = spotting_[spotter.side];
+
+	sight_.computeVisible(spotter.position, spotter.spotRange, visible_);
+	for (int index : visible_) {
+		if (on)
+			layer.addSpotter(index);
+		else
+			layer.removeSpotter(index);
+		spotLog_.push_back({spotter.side, index, on});
+	}
+}
+
+bool SimState::moveUnit(int unit, const HexCoord& target) {
+	const Unit& mover = units_[unit];
+	if (!mover.isAlive() || target.row < 0 || target.row >= rows_ || target.col < 0 || target.col >= cols_)
+		return false;
+	if (occupancy_[index(target)] >= 0)
+		return false;
+
+	int cost = gamelogic::enterCost(mover, terrain_[index(target)]);
+	if (cost >= 255 || cost > mover.movesLeft)
+		return false;
+
+	setSpotting(unit, false);
+	setOccupant(index(mover.position), -1);
+	Unit& moved = edit(unit);
+	moved.position = target;
+	moved.movesLeft = 0; // One move per turn
+	moved.hasMoved = true;
+	setOccupant(index(target), unit);
+	setSpotting(unit, true);
+	return true;
+}
+
+void SimState::setFacing(int unit, float facing) {
+	edit(unit).facing = facing;
+}
+
+int SimState::attack(int attacker, int target) {
+	const Unit& shooter = units_[attacker];
+	const Unit& victim = units_[target];
+	if (!shooter.isAlive() || !victim.isAlive() || shooter.hasFired)
+		return 0;
+	if (gamelogic::hexDistance(shooter.position, victim.position) > shooter.weaponRange)
+		return 0;
+
+	combatarcs::AttackArc arc = combatarcs::getAttackArc(shooter.position, victim.position, victim.facing);
+	int damage = 0;
+	ArmorLocation location;
+	if (hittables::rollAttack(arc, random_, location)) {
+		int attack = shooter.attack;
+		Unit& hit = edit(target);
+		damage = damagesystem::applyDamage(hit.locations, location, attack);
+
+		if (!hit.isAlive()) {
+			setSpotting(target, false);
+			setOccupant(index(hit.position), -1);
+		}
+	}
+
+	edit(attacker).hasFired = true;
+	return damage;
+}
+
+void SimState::endTurn() {
+	currentPlayer_ = 1 - currentPlayer_;
+	if (currentPlayer_ == 0)
+		currentTurn_++;
+
+	for (int i = 0; i < (int)units_.size(); i++) {
+		const Unit& unit = units_[i];
+		if (unit.side != currentPlayer_ || !unit.isAlive())
+			continue;
+		if (!unit.hasMoved && !unit.hasFired && unit.movesLeft == unit.movementPoints)
+			continue;
+		Unit& reset = edit(i);
+		reset.hasMoved = false;
+		reset.hasFired = false;
+		reset.movesLeft = reset.movementPoints;
+	}
+}
+
+SimState::Checkpoint SimState::checkpoint() const {
+	Checkpoint checkpoint;
+	checkpoint.units = unitLog_.size();
+	checkpoint.occupancy = occupancyLog_.size();
+	checkpoint.spotting = spotLog_.size();
+	checkpoint.random = random_.snapshot();
+	checkpoint.currentTurn = currentTurn_;
+	checkpoint.currentPlayer = currentPlayer_;
+	return checkpoint;
+}
+
+void SimState::rollback(const Checkpoint& checkpoint) {
+	// Newest first, so a value changed twice ends at its oldest record
+	while (unitLog_.size() > checkpoint.units) {
+		units_[unitLog_.back().unit] = unitLog_.back().before;
+		unitLog_.pop_back();
+	}
+	while (occupancyLog_.size() > checkpoint.occupancy) {
+		occupancy_[occupancyLog_.back().index] = occupancyLog_.back().before;
+		occupancyLog_.pop_back();
+	}
+	while (spotLog_.size() > checkpoint.spotting) {
+		const SpotChange& change = spotLog_.back();
+		if (change.added)
+			spotting_[change.side].removeSpotter(change.index);
+		else
+			spotting_[change.side].addSpotter(change.index);
+		spotLog_.pop_back();
+	}
+
+	random_.restore(checkpoint.random);
+	currentTurn_ = checkpoint.currentTurn;
+	currentPlayer_ = checkpoint.currentPlayer;
+}
+
+void SimState::commit() {
+	unitLog_.clear();
+	occupancyLog_.clear();
+	spotLog_.clear();
+}
+
+} // namespace sim
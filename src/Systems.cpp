@@ -1,63 +1,120 @@
 #include "Constants.hpp"
 #include "GameLogic.hpp"
-#include "UIPanels.hpp"
 
 #include <algorithm>
 #include <string>
 
-// Forward declaration for Rendering function
-namespace rendering {
-void clearSelectionHighlights(GameState &game);
-}
-
 namespace gamelogic {
 
 // ============================================================================
 // FOG OF WAR / SPOTTING
 // ============================================================================
 
+void syncSightTerrain(GameState &game) {
+	if (game.sight.terrainRevision == game.map.terrainRevision())
+		return;
+
+	game.sight.resize(game.map.rows(), game.map.cols());
+	for (int index = 0; index < game.map.size(); index++) {
+		game.sight.setOpacity(index, los::terrainOpacity(game.map.terrain(index)));
+	}
+	game.sight.terrainRevision = game.map.terrainRevision();
+}
+
+// Add or remove one spotter on a hex, recording the flip if there is one
+static void applySpot(GameState &game, int side, int index, bool on) {
+	visibility::VisibilityLayer &layer = game.map.spotting(side);
+	bool flipped = on ? layer.addSpotter(index) : layer.removeSpotter(index);
+	if (flipped) {
+		game.visibilityChanges.push_back({game.map.coord(index), side, on});
+	}
+}
+
 void setUnitSpotRange(GameState &game, Unit *unit, bool on) {
 	if (!unit)
 		return;
 
-	// Dead units should not contribute to spotting (except when clearing their spotting)
-	if (on && !unit->isAlive())
+	if (on) {
+		updateUnitSight(game, unit);
+	} else {
+		clearUnitSight(game, unit);
+	}
+}
+
+void updateUnitSight(GameState &game, Unit *unit) {
+	// Dead units should not contribute to spotting
+	if (!unit->isAlive()) {
+		clearUnitSight(game, unit);
 		return;
+	}
 
-	HexCoord pos = unit->position;
-	int range = unit->spotRange;
-	std::vector<HexCoord> cells = getCellsInRange(pos.row, pos.col, range);
+	syncSightTerrain(game);
 
-	for (const auto &cell : cells) {
-		GameHex &hex = game.map[cell.row][cell.col];
-		hex.setSpotted(unit->side, on);
+	SightCache &sight = game.units.details(*unit).sight;
+	if (sight.valid && sight.origin == unit->position && sight.range == unit->spotRange && sight.terrainRevision == game.map.terrainRevision())
+		return;
+
+	std::vector<int> next;
+	game.sight.computeVisible(unit->position, unit->spotRange, next);
+
+	// Both lists are sorted: walk them together and only touch hexes that
+	// are in one but not the other
+	const std::vector<int> &prev = sight.hexes;
+	size_t i = 0, j = 0;
+	while (i < prev.size() || j < next.size()) {
+		if (j == next.size() || (i < prev.size() && prev[i] < next[j])) {
+			applySpot(game, unit->side, prev[i++], false);
+		} else if (i == prev.size() || next[j] < prev[i]) {
+			applySpot(game, unit->side, next[j++], true);
+		} else {
+			i++;
+			j++;
+		}
 	}
+
+	sight.hexes.swap(next);
+	sight.origin = unit->position;
+	sight.range = unit->spotRange;
+	sight.terrainRevision = game.map.terrainRevision();
+	sight.valid = true;
 }
 
-void setSpotRangeAtPosition(GameState &game, int side, int spotRange, const HexCoord &pos, bool on) {
-	std::vector<HexCoord> cells = getCellsInRange(pos.row, pos.col, spotRange);
+void clearUnitSight(GameState &game, Unit *unit) {
+	SightCache &sight = game.units.details(*unit).sight;
+	for (int index : sight.hexes) {
+		applySpot(game, unit->side, index, false);
+	}
+	sight = SightCache();
+}
 
-	for (const auto &cell : cells) {
-		GameHex &hex = game.map[cell.row][cell.col];
-		hex.setSpotted(side, on);
+void refreshAllSight(GameState &game) {
+	// Cached fields are reused unless the unit moved or terrain changed
+	for (Unit *unit : game.units) {
+		updateUnitSight(game, unit);
 	}
 }
 
 void initializeAllSpotting(GameState &game) {
-	// Clear all spotting first
-	for (int row = 0; row < MAP_ROWS; row++) {
-		for (int col = 0; col < MAP_COLS; col++) {
-			game.map[row][col].spotted[0] = 0;
-			game.map[row][col].spotted[1] = 0;
-		}
+	// Full rebuild: clear all spotting first. The change list restarts from
+	// here, consumers should treat a rebuild as a full refresh.
+	game.map.spotting(0).clear();
+	game.map.spotting(1).clear();
+	for (Unit *unit : game.units) {
+		game.units.details(*unit).sight = SightCache();
 	}
 
 	// Set spotting for all living units only
-	for (auto &unit : game.units) {
-		if (unit->isAlive()) {
-			setUnitSpotRange(game, unit.get(), true);
-		}
-	}
+	refreshAllSight(game);
+	game.visibilityChanges.clear();
+
+	// Nothing counts as newly visible on the first turn
+	game.map.spotting(0).markTurnStart();
+	game.map.spotting(1).markTurnStart();
+}
+
+bool hasLineOfSight(GameState &game, const HexCoord &from, const HexCoord &to) {
+	syncSightTerrain(game);
+	return game.sight.hasLineOfSight(from, to);
 }
 
 // ============================================================================
@@ -67,7 +124,7 @@ void initializeAllSpotting(GameState &game) {
 void endTurn(GameState &game) {
 	// Log turn end
 	std::string playerName = game.currentPlayer == 0 ? "Axis" : "Allied";
-	addLogMessage(game, playerName + " turn ended");
+	addLogMessage(game, combatlog::LogTemplate::TURN_ENDED, {playerName});
 
 	// Switch player
 	game.currentPlayer = 1 - game.currentPlayer;
@@ -75,15 +132,15 @@ void endTurn(GameState &game) {
 	// If both players have moved, advance turn
 	if (game.currentPlayer == 0) {
 		game.currentTurn++;
-		addLogMessage(game, "--- Turn " + std::to_string(game.currentTurn) + " ---");
+		addLogMessage(game, combatlog::LogTemplate::TURN_HEADER, {game.currentTurn});
 	}
 
 	// Log new player turn
 	playerName = game.currentPlayer == 0 ? "Axis" : "Allied";
-	addLogMessage(game, playerName + " turn begins");
+	addLogMessage(game, combatlog::LogTemplate::TURN_BEGINS, {playerName});
 
 	// Reset actions for units about to start their turn (skip dead units)
-	for (auto &unit : game.units) {
+	for (Unit *unit : game.units) {
 		if (unit->side == game.currentPlayer && unit->isAlive()) {
 			unit->hasMoved = false;
 			unit->hasFired = false;
@@ -92,16 +149,28 @@ void endTurn(GameState &game) {
 	}
 
 	// Clear selection and movement state
-	game.selectedUnit = nullptr;
+	game.selected = UnitHandle();
 	game.movementSel.reset();
-	rendering::clearSelectionHighlights(game);
+	game.moveHistory.clear();
+	game.map.clearSelection();
+
+	if (game.hooks.turnEnded)
+		game.hooks.turnEnded(game);
+
+	// Recompute LOS for units whose position or terrain changed
+	refreshAllSight(game);
+
+	// Visibility changes are reported per turn
+	game.visibilityChanges.clear();
+	game.map.spotting(0).markTurnStart();
+	game.map.spotting(1).markTurnStart();
 
-	// Hide paperdoll panels on turn end
-	uipanel::hideTargetPanel(game);
-	uipanel::hidePlayerPanel(game);
+	// Combat events are buffered per turn
+	game.combatEvents.clear();
 
-	// Clear attack lines when ending turn
+	// Clear attack lines and their cached odds when ending turn
 	game.attackLines.clear();
+	game.oddsCache.clear();
 	game.showAttackLines = false;
 }
 
@@ -0,0 +1,114 @@
+#include "TerrainMesh.hpp"
+#include "Hex.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+TerrainMesh::TerrainMesh()
+    : fillIndexCount_(0), minX_(0.0f), minY_(0.0f), maxX_(0.0f), maxY_(0.0f), terrainRevision_(0), hexSize_(0.0f), built_(false) {
+}
+
+uint32_t TerrainMesh::addVertex(float x, float y, MeshColor color) {
+	vertices_.push_back({x, y, color});
+	return (uint32_t)vertices_.size() - 1;
+}
+
+void TerrainMesh::addTriangle(uint32_t a, uint32_t b, uint32_t c) {
+	// Screen space is y-down: raylib's counter-clockwise triangles have a
+	// negative cross product here
+	const MeshVertex& va = vertices_[a];
+	const MeshVertex& vb = vertices_[b];
+	const MeshVertex& vc = vertices_[c];
+	float cross = (vb.x - va.x) * (vc.y - va.y) - (vb.y - va.y) * (vc.x - va.x);
+	indices_.push_back(a);
+	if (cross > 0.0f) {
+		indices_.push_back(c);
+		indices_.push_back(b);
+	} else {
+		indices_.push_back(b);
+		indices_.push_back(c);
+	}
+}
+
+void TerrainMesh::build(const HexMap& map, float hexSize, const MeshColor* palette, MeshColor gridColor, float gridWidth) {
+	const HexTopology& topology = map.topology();
+	int hexCount = map.size();
+
+	vertices_.clear();
+	indices_.clear();
+	gridStart_.clear();
+	gridStart_.reserve((size_t)hexCount + 1);
+	vertices_.reserve((size_t)hexCount * kFillVerticesPerHex + (size_t)hexCount * 3 * kEdgeVertices);
+	indices_.reserve((size_t)hexCount * kFillIndicesPerHex + (size_t)hexCount * 3 * kEdgeIndices);
+
+	Layout layout(kLayoutPointy, Point(hexSize, hexSize), Point(0, 0));
+	const CornerTable& cornerOffsets = layout.cornerOffsets;
+
+	// Terrain fills: a 6-triangle fan around the hex center
+	for (int index = 0; index < hexCount; index++) {
+		HexCoord coord = map.coord(index);
+		Point center = HexToPixel(layout, OffsetToCube(OffsetCoord(coord.col, coord.row)));
+		MeshColor color = palette[static_cast<int>(map.terrain(index))];
+
+		uint32_t centerVertex = addVertex((float)center.x, (float)center.y, color);
+		for (int i = 0; i < 6; i++) {
+			addVertex((float)(center.x + cornerOffsets[i].x), (float)(center.y + cornerOffsets[i].y), color);
+		}
+		for (int i = 0; i < 6; i++) {
+			addTriangle(centerVertex + 1 + (i + 1) % 6, centerVertex + 1 + i, centerVertex);
+		}
+	}
+	fillIndexCount_ = (int)indices_.size();
+
+	// Grid lines: each edge is owned by the lower-index hex (or the only hex
+	// for map border edges)
+	float halfWidth = gridWidth * 0.5f;
+	for (int index = 0; index < hexCount; index++) {
+		HexCoord coord = map.coord(index);
+		Point center = HexToPixel(layout, OffsetToCube(OffsetCoord(coord.col, coord.row)));
+		const int* neighbors = topology.neighbors(index);
+		gridStart_.push_back((uint32_t)indices_.size());
+
+		for (int dir = 0; dir < HexTopology::kDirections; dir++) {
+			if (neighbors[dir] >= 0 && neighbors[dir] < index)
+				continue;
+
+			// Direction dir crosses edge (5 - dir): corners (5 - dir) and (6 - dir)
+			int edge = (5 - dir + 6) % 6;
+			float x1 = (float)(center.x + cornerOffsets[edge].x);
+			float y1 = (float)(center.y + cornerOffsets[edge].y);
+			float x2 = (float)(center.x + cornerOffsets[(edge + 1) % 6].x);
+			float y2 = (float)(center.y + cornerOffsets[(edge + 1) % 6].y);
+
+			float dx = x2 - x1, dy = y2 - y1;
+			float length = std::sqrt(dx * dx + dy * dy);
+			float nx = -dy / length * halfWidth;
+			float ny = dx / length * halfWidth;
+
+			uint32_t v0 = addVertex(x1 + nx, y1 + ny, gridColor);
+			uint32_t v1 = addVertex(x1 - nx, y1 - ny, gridColor);
+			uint32_t v2 = addVertex(x2 - nx, y2 - ny, gridColor);
+			uint32_t v3 = addVertex(x2 + nx, y2 + ny, gridColor);
+			addTriangle(v0, v1, v2);
+			addTriangle(v0, v2, v3);
+		}
+	}
+
+	gridStart_.push_back((uint32_t)indices_.size());
+
+	minX_ = minY_ = maxX_ = maxY_ = 0.0f;
+	if (!vertices_.empty()) {
+		minX_ = maxX_ = vertices_[0].x;
+		minY_ = maxY_ = vertices_[0].y;
+		for (const MeshVertex& v : vertices_) {
+			minX_ = std::min(minX_, v.x);
+			maxX_ = std::max(maxX_, v.x);
+			minY_ = std::min(minY_, v.y);
+			maxY_ = std::max(maxY_, v.y);
+		}
+	}
+
+	terrainRevision_ = map.terrainRevision();
+	hexSize_ = hexSize;
+	built_ = true;
+}
@@ -0,0 +1,126 @@
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+
+// Worker index of the current thread and the pool it belongs to
+static thread_local int tWorker = -1;
+static thread_local const ThreadPool* tPool = nullptr;
+
+ThreadPool::ThreadPool(int threads)
+    : queued_(0), pending_(0), nextQueue_(0), stopping_(false) {
+	if (threads <= 0)
+		threads = std::max(1, (int)std::thread::hardware_concurrency());
+
+	for (int i = 0; i < threads; i++) {
+		queues_.push_back(std::make_unique<Queue>());
+	}
+	for (int i = 0; i < threads; i++) {
+		workers_.emplace_back(&ThreadPool::run, this, i);
+	}
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex_);
+		stopping_ = true;
+	}
+	wake_.notify_all();
+	for (std::thread& worker : workers_) {
+		worker.join();
+	}
+}
+
+int ThreadPool::currentWorker() {
+	return tWorker;
+}
+
+void ThreadPool::submit(Task task) {
+	int index = tPool == this ? tWorker : (int)(nextQueue_++ % (unsigned)queues_.size());
+
+	pending_++;
+	{
+		std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+		queues_[index]->tasks.push_back(std::move(task));
+	}
+
+	// queued_ changes under sleepMutex_ so a worker about to sleep can't
+	// miss the wakeup
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex_);
+		queued_++;
+	}
+	wake_.notify_one();
+}
+
+bool ThreadPool::pop(int index, Task& task) {
+	// Own deque first, newest task (still warm in cache)
+	{
+		Queue& own = *queues_[index];
+		std::lock_guard<std::mutex> lock(own.mutex);
+		if (!own.tasks.empty()) {
+			task = std::move(own.tasks.back());
+			own.tasks.pop_back();
+			queued_--;
+			return true;
+		}
+	}
+
+	// Steal the oldest task from the next non-empty deque
+	int count = (int)queues_.size();
+	for (int i = 1; i < count; i++) {
+		Queue& other = *queues_[(index + i) % count];
+		std::lock_guard<std::mutex> lock(other.mutex);
+		if (!other.tasks.empty()) {
+			task = std::move(other.tasks.front());
+			other.tasks.pop_front();
+			queued_--;
+			return true;
+		}
+	}
+	return false;
+}
+
+void ThreadPool::run(int index) {
+	tWorker = index;
+	tPool = this;
+
+	for (;;) {
+		Task task;
+		if (pop(index, task)) {
+			task(index);
+			if (--pending_ == 0) {
+				std::lock_guard<std::mutex> lock(sleepMutex_);
+				idle_.notify_all();
+			}
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(sleepMutex_);
+		wake_.wait(lock, [this] { return stopping_ || queued_ > 0; });
+		if (stopping_ && queued_ == 0)
+			return;
+	}
+}
+
+void ThreadPool::wait() {
+	std::unique_lock<std::mutex> lock(sleepMutex_);
+	idle_.wait(lock, [this] { return pending_ == 0; });
+}
+
+void ThreadPool::parallelFor(int count, const std::function<void(int index, int worker)>& fn, int grain) {
+	if (count <= 0)
+		return;
+	// About eight chunks per worker leaves room to balance uneven work
+	if (grain <= 0)
+		grain = std::max(1, count / (size() * 8));
+
+	for (int first = 0; first < count; first += grain) {
+		int last = std::min(count, first + grain);
+		submit([&fn, first, last](int worker) {
+			for (int i = first; i < last; i++) {
+				fn(i, worker);
+			}
+		});
+	}
+	wait();
+}
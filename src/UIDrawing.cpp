@@ -11,12 +11,135 @@
 #include "UIPanels.hpp"
 
 #include <algorithm>
-#include <sstream>
 #include <string>
 #include <vector>
 
 namespace rendering {
 
+// Word-wrap one log record (with its turn prefix and repeat count) onto the
+// end of lines and return the number of lines added. Each word is measured
+// once: raylib has no kerning, so a line's width is the sum of its words,
+// the spaces between them and the glyph spacing at each join.
+static int wrapLogRecord(const combatlog::LogStore &store, const combatlog::LogRecord &record, float width,
+                         std::vector<std::string> &lines) {
+	const float fontSize = (float)cherrystyle::kFontSize;
+	const float spacing = (float)cherrystyle::kFontSpacing;
+	const float spaceWidth = MeasureTextEx(cherrystyle::CHERRY_FONT, " ", fontSize, spacing).x;
+
+	std::string text;
+	store.format(record, text);
+	std::string fullMsg = "[T" + std::to_string(record.turn) + "] " + text;
+	if (record.count > 1) {
+		fullMsg += " (x" + std::to_string(record.count) + ")";
+	}
+
+	size_t firstLine = lines.size();
+	std::string currentLine;
+	float lineWidth = 0.0f;
+	size_t pos = 0;
+	while (pos < fullMsg.size()) {
+		if (fullMsg[pos] == ' ') {
+			pos++;
+			continue;
+		}
+		size_t end = fullMsg.find(' ', pos);
+		if (end == std::string::npos)
+			end = fullMsg.size();
+		std::string word = fullMsg.substr(pos, end - pos);
+		pos = end;
+
+		float wordWidth = MeasureTextEx(cherrystyle::CHERRY_FONT, word.c_str(), fontSize, spacing).x;
+		if (currentLine.empty()) {
+			currentLine = word;
+			lineWidth = wordWidth;
+			continue;
+		}
+
+		float joinedWidth = lineWidth + spacing + spaceWidth + spacing + wordWidth;
+		if ((int)joinedWidth > (int)width) {
+			// Current line is full, save it
+			lines.push_back(currentLine);
+			currentLine = word;
+			lineWidth = wordWidth;
+		} else {
+			currentLine += ' ';
+			currentLine += word;
+			lineWidth = joinedWidth;
+		}
+	}
+
+	// Add remaining text
+	if (!currentLine.empty()) {
+		lines.push_back(currentLine);
+	}
+	return (int)(lines.size() - firstLine);
+}
+
+// Bring the line offsets up to date with the record store. New records
+// extend the cached text if the cache already reaches the end of the log.
+static void updateCombatLogLayout(CombatLog &log, float width) {
+	CombatLogLayout &layout = log.layout;
+	const combatlog::LogStore &store = log.records;
+	int recordCount = store.size();
+
+	if (layout.wrapWidth != width || layout.recordCount() > recordCount) {
+		layout.clear();
+		layout.wrapWidth = width;
+	}
+
+	// A repeat of the last laid out record bumps its count in place: re-wrap it
+	int laidOut = layout.recordCount();
+	combatlog::LogRecord record;
+	if (laidOut > 0 && store.get(laidOut - 1, record) && record.count != layout.lastCount) {
+		laidOut--;
+		if (layout.cacheEnd > laidOut && layout.cacheFirst < laidOut) {
+			layout.lines.resize(layout.lineOf(laidOut) - layout.lineOf(layout.cacheFirst));
+			layout.cacheEnd = laidOut;
+		} else if (layout.cacheEnd > laidOut) {
+			layout.dropCache();
+		}
+		layout.popBack();
+	}
+	if (laidOut == recordCount)
+		return;
+
+	std::vector<std::string> scratch;
+	for (int i = laidOut; i < recordCount; i++) {
+		bool extendCache = layout.cacheEnd == i && layout.cacheEnd - layout.cacheFirst < CombatLogLayout::kMaxCachedRecords;
+		std::vector<std::string> &target = extendCache ? layout.lines : scratch;
+		scratch.clear();
+
+		int lineCount = store.get(i, record) ? wrapLogRecord(store, record, width, target) : 0;
+		layout.append(lineCount);
+		if (extendCache) {
+			layout.cacheEnd++;
+		} else if (layout.cacheEnd == i) {
+			layout.dropCache();
+		}
+	}
+	layout.lastCount = store.back().count;
+}
+
+// Make sure the wrapped text for records [first, end) is cached
+static void cacheCombatLogLines(CombatLog &log, int first, int end) {
+	CombatLogLayout &layout = log.layout;
+	if (layout.cacheFirst <= first && end <= layout.cacheEnd)
+		return;
+
+	layout.lines.clear();
+	layout.cacheFirst = std::max(0, first - CombatLogLayout::kCacheMargin);
+	layout.cacheEnd = std::min(layout.recordCount(), end + CombatLogLayout::kCacheMargin);
+
+	combatlog::LogRecord record;
+	int cacheLine = layout.lineOf(layout.cacheFirst);
+	for (int i = layout.cacheFirst; i < layout.cacheEnd; i++) {
+		if (log.records.get(i, record))
+			wrapLogRecord(log.records, record, layout.wrapWidth, layout.lines);
+		// Keep the cache aligned with the line offsets even if a page read failed
+		layout.lines.resize(layout.lineOf(i + 1) - cacheLine);
+	}
+}
+
 void drawCombatLog(GameState &game) {
 	// Use fixed font size from Cherry style
 	const int fontSize = cherrystyle::kFontSize;
@@ -52,47 +175,12 @@ void drawCombatLog(GameState &game) {
 	Vector2 mousePos = GetMousePosition();
 	game.combatLog.isHovering = CheckCollisionPointRec(mousePos, bounds);
 
-	// Build display lines with word wrapping
-	std::vector<std::string> displayLines;
-	std::vector<Color> lineColors;
-
-	for (const auto &msg : game.combatLog.messages) {
-		// Format message with turn prefix and count
-		std::string prefix = "[T" + std::to_string(msg.turn) + "] ";
-		std::string fullMsg = prefix + msg.message;
-		if (msg.count > 1) {
-			fullMsg += " (x" + std::to_string(msg.count) + ")";
-		}
-
-		// Word wrap the message
-		int maxWidth = (int)textArea.width;
-		std::string currentLine;
-		std::istringstream words(fullMsg);
-		std::string word;
-
-		while (words >> word) {
-			std::string testLine = currentLine.empty() ? word : currentLine + " " + word;
-			int textWidth = (int)MeasureTextEx(cherrystyle::CHERRY_FONT, testLine.c_str(), (float)fontSize, spacing).x;
-
-			if (textWidth > maxWidth && !currentLine.empty()) {
-				// Current line is full, save it
-				displayLines.push_back(currentLine);
-				lineColors.push_back(textColor);
-				currentLine = word;
-			} else {
-				currentLine = testLine;
-			}
-		}
-
-		// Add remaining text
-		if (!currentLine.empty()) {
-			displayLines.push_back(currentLine);
-			lineColors.push_back(textColor);
-		}
-	}
+	// Lay out any new records; this is a no-op on most frames
+	CombatLogLayout &layout = game.combatLog.layout;
+	updateCombatLogLayout(game.combatLog, textArea.width);
 
 	// Calculate total content height
-	float totalContentHeight = displayLines.size() * lineSpacing;
+	float totalContentHeight = layout.lineCount() * lineSpacing;
 	float visibleHeight = textArea.height;
 
 	// Update max scroll offset
@@ -104,14 +192,23 @@ void drawCombatLog(GameState &game) {
 	// Enable scissor mode for clipping
 	BeginScissorMode((int)textArea.x, (int)textArea.y, (int)textArea.width, (int)textArea.height);
 
-	// Draw messages from top to bottom, applying scroll offset
-	int yPos = (int)(textArea.y - game.combatLog.scrollOffset);
-
-	for (size_t i = 0; i < displayLines.size(); i++) {
-		if (yPos + lineSpacing >= textArea.y && yPos <= textArea.y + textArea.height) {
-			DrawTextEx(cherrystyle::CHERRY_FONT, displayLines[i].c_str(), Vector2 {textArea.x, (float)yPos}, (float)fontSize, spacing, lineColors[i]);
+	// Lines have a fixed height, so the visible lines follow directly from
+	// the scroll offset; the records holding them come from a binary search
+	// over the cumulative line offsets.
+	int lineCount = layout.lineCount();
+	int firstLine = std::min(lineCount, (int)(game.combatLog.scrollOffset / lineSpacing));
+	int lastLine = std::min(lineCount, (int)((game.combatLog.scrollOffset + visibleHeight) / lineSpacing) + 1);
+	if (firstLine < lastLine) {
+		int firstRecord = layout.recordAt(firstLine);
+		int endRecord = layout.recordAt(lastLine - 1) + 1;
+		cacheCombatLogLines(game.combatLog, firstRecord, endRecord);
+
+		int cacheLine = layout.lineOf(layout.cacheFirst);
+		int yPos = (int)(textArea.y - game.combatLog.scrollOffset) + firstLine * lineSpacing;
+		for (int i = firstLine; i < lastLine; i++) {
+			DrawTextEx(cherrystyle::CHERRY_FONT, layout.lines[i - cacheLine].c_str(), Vector2 {textArea.x, (float)yPos}, (float)fontSize, spacing, textColor);
+			yPos += lineSpacing;
 		}
-		yPos += lineSpacing;
 	}
 
 	EndScissorMode();
@@ -150,7 +247,7 @@ void drawCombatLog(GameState &game) {
 }
 
 void drawUnitInfoBox(GameState &game) {
-	if (!game.selectedUnit || game.showOptionsMenu)
+	if (!game.selectedUnit() || game.showOptionsMenu)
 		return;
 
 	// Use fixed font size from Cherry style
@@ -171,20 +268,20 @@ void drawUnitInfoBox(GameState &game) {
 	DrawRectangleRec(bounds, backgroundColor);
 	DrawRectangleLinesEx(bounds, 1, borderColor); // 1px border
 
-	Unit *unit = game.selectedUnit;
+	Unit *unit = game.selectedUnit();
 	int y = (int)bounds.y + (int)padding;
 	int x = (int)bounds.x + (int)padding;
 	float spacing = (float)cherrystyle::kFontSpacing;
 
 	// Draw unit name
-	DrawTextEx(cherrystyle::CHERRY_FONT, unit->name.c_str(), Vector2 {(float)x, (float)y}, (float)fontSize, spacing, textColor);
+	DrawTextEx(cherrystyle::CHERRY_FONT, game.units.details(*unit).name.c_str(), Vector2 {(float)x, (float)y}, (float)fontSize, spacing, textColor);
 	y += fontSize + 12;
 
 	std::string info = "Health: " + std::to_string(unit->getOverallHealthPercent()) + "%";
 	DrawTextEx(cherrystyle::CHERRY_FONT, info.c_str(), Vector2 {(float)x, (float)y}, (float)fontSize, spacing, textColor);
 	y += lineSpacing;
 
-	const LocationStatus &center = unit->locations.at(ArmorLocation::CENTER);
+	const LocationStatus &center = unit->locations[ArmorLocation::CENTER];
 	info = "Center Armor: " + std::to_string(center.currentArmor) + "/" + std::to_string(center.maxArmor);
 	DrawTextEx(cherrystyle::CHERRY_FONT, info.c_str(), Vector2 {(float)x, (float)y}, (float)fontSize, spacing, textColor);
 	y += lineSpacing;
@@ -239,15 +336,15 @@ void drawUI(GameState &game) {
 	HexCoord hoveredHex = offsetToGameCoord(offset);
 
 	if (hoveredHex.row >= 0 && hoveredHex.row < MAP_ROWS && hoveredHex.col >= 0 && hoveredHex.col < MAP_COLS) {
-		GameHex &hex = game.map[hoveredHex.row][hoveredHex.col];
-		std::string terrainName = gamelogic::getTerrainName(hex.terrain);
+		TerrainType terrain = game.map.terrain(hoveredHex);
+		std::string terrainName = gamelogic::getTerrainName(terrain);
 
 		// Get movement cost (use selected unit's movement method if available, otherwise use TRACKED as default)
 		int moveCost = 255;
-		if (game.selectedUnit) {
-			moveCost = gamelogic::getMovementCost(game.selectedUnit->movMethod, hex.terrain);
+		if (game.selectedUnit()) {
+			moveCost = gamelogic::getMovementCost(game.selectedUnit()->movMethod, terrain);
 		} else {
-			moveCost = gamelogic::getMovementCost(MovMethod::TRACKED, hex.terrain);
+			moveCost = gamelogic::getMovementCost(MovMethod::TRACKED, terrain);
 		}
 
 		std::string costStr;
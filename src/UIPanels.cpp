@@ -48,26 +48,31 @@ void initializePlayerPanel(GameState& game) {
 }
 
 void showTargetPanel(GameState& game, Unit* target, combatarcs::AttackArc arc) {
-	game.targetPanel.targetUnit = target;
+	game.targetPanel.targetUnit = target->handle;
 	game.targetPanel.currentArc = arc;
 	game.targetPanel.isVisible = true;
 	calculatePaperdollRegions(game.targetPanel);
 }
 
 void showPlayerPanel(GameState& game, Unit* player) {
-	game.playerPanel.playerUnit = player;
+	game.playerPanel.playerUnit = player->handle;
 	game.playerPanel.isVisible = true;
 	calculatePaperdollRegions(game.playerPanel);
 }
 
 void hideTargetPanel(GameState& game) {
 	game.targetPanel.isVisible = false;
-	game.targetPanel.targetUnit = nullptr;
+	game.targetPanel.targetUnit = UnitHandle();
 }
 
 void hidePlayerPanel(GameState& game) {
 	game.playerPanel.isVisible = false;
-	game.playerPanel.playerUnit = nullptr;
+	game.playerPanel.playerUnit = UnitHandle();
+}
+
+void onTurnEnded(GameState& game) {
+	hideTargetPanel(game);
+	hidePlayerPanel(game);
 }
 
 void resetPanelPositions(GameState& game) {
@@ -50,7 +50,7 @@ void Unit::initializeLocations(WeightClass wClass) {
 
 bool Unit::isAlive() const {
 	// Mech is destroyed when CENTER is destroyed
-	return !locations.at(ArmorLocation::CENTER).isDestroyed;
+	return !locations[ArmorLocation::CENTER].isDestroyed;
 }
 
 bool Unit::canMove() const {
@@ -61,8 +61,7 @@ int Unit::getOverallHealthPercent() const {
 	int totalCurrent = 0;
 	int totalMax = 0;
 
-	for (const auto& pair : locations) {
-		const LocationStatus& status = pair.second;
+	for (const LocationStatus& status : locations) {
 		totalCurrent += status.currentArmor + status.currentStructure;
 		totalMax += status.maxArmor + status.maxStructure;
 	}
@@ -72,31 +71,31 @@ int Unit::getOverallHealthPercent() const {
 	return (totalCurrent * 100) / totalMax;
 }
 
-void Unit::initializeWeapons() {
+void UnitDetails::initializeWeapons(Unit::WeightClass weightClass) {
 	weapons.clear();
 
 	// Assign weapons based on weight class for testing variety
 	switch (weightClass) {
-		case WeightClass::LIGHT:
+		case Unit::WeightClass::LIGHT:
 			weapons.push_back(Weapon("L LASER", WeaponType::ENERGY, 5));
 			weapons.push_back(Weapon("S LASER", WeaponType::ENERGY, 3));
 			weapons.push_back(Weapon("SRM2", WeaponType::MISSILE, 2));
 			break;
 
-		case WeightClass::MEDIUM:
+		case Unit::WeightClass::MEDIUM:
 			weapons.push_back(Weapon("M LASER", WeaponType::ENERGY, 7));
 			weapons.push_back(Weapon("LRM5", WeaponType::MISSILE, 5));
 			weapons.push_back(Weapon("AC/5", WeaponType::BALLISTIC, 5));
 			break;
 
-		case WeightClass::HEAVY:
+		case Unit::WeightClass::HEAVY:
 			weapons.push_back(Weapon("PPC", WeaponType::ENERGY, 10));
 			weapons.push_back(Weapon("SRM6", WeaponType::MISSILE, 2));
 			weapons.push_back(Weapon("AC/10", WeaponType::BALLISTIC, 10));
 			weapons.push_back(Weapon("M LASER", WeaponType::ENERGY, 7));
 			break;
 
-		case WeightClass::ASSAULT:
+		case Unit::WeightClass::ASSAULT:
 			weapons.push_back(Weapon("AC/20", WeaponType::BALLISTIC, 20));
 			weapons.push_back(Weapon("LRM15", WeaponType::MISSILE, 15));
 			weapons.push_back(Weapon("ER L LASER", WeaponType::ENERGY, 8));
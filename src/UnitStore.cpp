@@ -0,0 +1,64 @@
+#include "UnitStore.hpp"
+
+UnitStore::UnitStore()
+    : liveCount_(0) {
+}
+
+UnitHandle UnitStore::create() {
+	uint32_t index;
+	if (!freeSlots_.empty()) {
+		index = freeSlots_.back();
+		freeSlots_.pop_back();
+	} else {
+		index = slotCount();
+		if (index % kChunkSize == 0)
+			chunks_.push_back(std::make_unique<Unit[]>(kChunkSize));
+		generations_.push_back(0);
+		live_.push_back(0);
+		details_.emplace_back();
+	}
+
+	// Generation 0 is reserved for the null handle
+	generations_[index]++;
+	if (generations_[index] == 0)
+		generations_[index] = 1;
+	live_[index] = 1;
+	liveCount_++;
+
+	UnitHandle handle(index, generations_[index]);
+	slot(index) = Unit();
+	slot(index).handle = handle;
+	details_[index] = UnitDetails();
+	return handle;
+}
+
+void UnitStore::destroy(UnitHandle handle) {
+	if (!get(handle))
+		return;
+	live_[handle.index] = 0;
+	generations_[handle.index]++;
+	details_[handle.index] = UnitDetails();
+	freeSlots_.push_back(handle.index);
+	liveCount_--;
+}
+
+void UnitStore::clear() {
+	for (uint32_t index = 0; index < slotCount(); index++) {
+		if (live_[index])
+			destroy(UnitHandle(index, generations_[index]));
+	}
+}
+
+Unit* UnitStore::get(UnitHandle handle) {
+	if (handle.isNull() || handle.index >= slotCount() || !live_[handle.index] ||
+	    generations_[handle.index] != handle.generation)
+		return nullptr;
+	return &slot(handle.index);
+}
+
+const Unit* UnitStore::get(UnitHandle handle) const {
+	if (handle.isNull() || handle.index >= slotCount() || !live_[handle.index] ||
+	    generations_[handle.index] != handle.generation)
+		return nullptr;
+	return &slot(handle.index);
+}
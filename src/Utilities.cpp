@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cmath>
 #include <cstdio>
 #include "Constants.hpp"
@@ -200,63 +201,118 @@ int hexDistance(const HexCoord& a, const HexCoord& b) {
 	return (abs(cubeA.q - cubeB.q) + abs(cubeA.r - cubeB.r) + abs(cubeA.s - cubeB.s)) / 2;
 }
 
-// Get all adjacent hexes (6 neighbors)
-std::vector<HexCoord> getAdjacent(int row, int col) {
-	std::vector<HexCoord> result;
-	OffsetCoord center(col, row);
-	::Hex cubeHex = OffsetToCube(center);
-
-	for (int i = 0; i < 6; i++) {
-		::Hex neighbor = HexNeighbor(cubeHex, i);
-		OffsetCoord neighborOffset = CubeToOffset(neighbor);
-
-		if (neighborOffset.row >= 0 && neighborOffset.row < MAP_ROWS && neighborOffset.col >= 0 && neighborOffset.col < MAP_COLS) {
-			result.push_back({neighborOffset.row, neighborOffset.col});
-		}
-	}
-
-	return result;
+// Column span of the hex disk around center within one map row, clipped to
+// the map. In cube space the disk row at offset dr covers a contiguous q
+// interval, which maps to a contiguous column interval in odd-r offsets.
+bool getRangeRowSpan(const HexCoord& center, int range, int row, int& colMin, int& colMax) {
+	int dr = row - center.row;
+	if (dr < -range || dr > range || row < 0 || row >= MAP_ROWS)
+		return false;
+
+	int centerQ = center.col - (center.row - (center.row & 1)) / 2;
+	int rowShift = (row - (row & 1)) / 2;
+	colMin = std::max(0, centerQ + std::max(-range, -dr - range) + rowShift);
+	colMax = std::min(MAP_COLS - 1, centerQ + std::min(range, -dr + range) + rowShift);
+	return colMin <= colMax;
 }
 
-// Get all cells within a given range
-std::vector<HexCoord> getCellsInRange(int row, int col, int range) {
-	std::vector<HexCoord> result;
-
-	for (int r = 0; r < MAP_ROWS; r++) {
-		for (int c = 0; c < MAP_COLS; c++) {
-			HexCoord target = {r, c};
-			HexCoord center = {row, col};
-			int dist = hexDistance(center, target);
-
-			if (dist <= range) {
-				result.push_back(target);
-			}
+// Get all cells within a given range (visits only the disk, not the map)
+void getCellsInRange(int row, int col, int range, std::vector<HexCoord>& out) {
+	out.clear();
+	HexCoord center = {row, col};
+	int colMin, colMax;
+
+	for (int r = std::max(0, row - range); r <= std::min(MAP_ROWS - 1, row + range); r++) {
+		if (!getRangeRowSpan(center, range, r, colMin, colMax))
+			continue;
+		for (int c = colMin; c <= colMax; c++) {
+			out.push_back({r, c});
 		}
 	}
-
-	return result;
 }
 
 // ============================================================================
 // COMBAT LOG HELPERS
 // ============================================================================
 
-void addLogMessage(GameState& game, const std::string& message) {
-	// Check if last message is the same (for deduplication)
-	if (!game.combatLog.messages.empty()) {
-		LogMessage& last = game.combatLog.messages.back();
-		if (last.turn == game.currentTurn && last.message == message) {
-			last.count++;
-			return;
-		}
-	}
-
-	// Add new message
-	game.combatLog.messages.emplace_back(game.currentTurn, message);
+void addLogMessage(GameState& game, combatlog::LogTemplate id, std::initializer_list<combatlog::LogArg> args) {
+	// Repeats of the last message only bump its count
+	if (!game.combatLog.records.push(id, game.currentTurn, args))
+		return;
 
 	// Auto-scroll to bottom (most recent) by setting scroll to max
 	// We'll calculate the actual max in the rendering function
 	game.combatLog.scrollOffset = 999999.0f; // Large value to force scroll to bottom
 }
 
+static const char* sideName(const Unit* unit) {
+	return unit->side == 0 ? "Axis" : "Allied";
+}
+
+static const char* arcName(combatarcs::AttackArc arc) {
+	switch (arc) {
+		case combatarcs::AttackArc::FRONT:
+			return "FRONT";
+		case combatarcs::AttackArc::LEFT_SIDE:
+			return "LEFT SIDE";
+		case combatarcs::AttackArc::RIGHT_SIDE:
+			return "RIGHT SIDE";
+		case combatarcs::AttackArc::REAR:
+			return "REAR";
+	}
+	return "";
+}
+
+void logCombatEvent(GameState& game, const combatevents::CombatEvent& event) {
+	using combatevents::CombatEventType;
+	using combatlog::LogTemplate;
+
+	switch (event.type) {
+		case CombatEventType::ATTACK_DECLARED:
+			addLogMessage(game, LogTemplate::FIRES_AT, {game.units.details(*event.attacker).name, sideName(event.attacker), game.units.details(*event.defender).name, sideName(event.defender)});
+			break;
+		case CombatEventType::ARC_RESOLVED:
+			addLogMessage(game, LogTemplate::ATTACK_ARC, {arcName(event.arc)});
+			break;
+		case CombatEventType::MISS:
+			addLogMessage(game, LogTemplate::MISS);
+			addLogMessage(game, LogTemplate::SEPARATOR);
+			break;
+		case CombatEventType::LOCATION_HIT:
+			if (!event.transferred)
+				addLogMessage(game, LogTemplate::HIT_LOCATION, {locationToString(event.location)});
+			addLogMessage(game, LogTemplate::DAMAGE_TAKEN, {event.amount, locationToString(event.location)});
+			break;
+		case CombatEventType::ARMOR_ABSORBED:
+			addLogMessage(game, LogTemplate::ARMOR_DAMAGE, {locationToString(event.location), event.before, event.after, event.amount});
+			if (event.overflow > 0)
+				addLogMessage(game, LogTemplate::STRUCTURE_OVERFLOW, {event.overflow});
+			break;
+		case CombatEventType::STRUCTURE_DAMAGED:
+			addLogMessage(game, LogTemplate::STRUCTURE_DAMAGE, {locationToString(event.location), event.before, event.after, event.amount});
+			break;
+		case CombatEventType::LOCATION_DESTROYED:
+			addLogMessage(game, LogTemplate::LOCATION_DESTROYED, {locationToString(event.location)});
+			if (event.location == ArmorLocation::CENTER)
+				addLogMessage(game, LogTemplate::MECH_DEATH);
+			break;
+		case CombatEventType::DAMAGE_TRANSFERRED:
+			addLogMessage(game, LogTemplate::DAMAGE_TRANSFER, {event.amount, locationToString(event.transferTo)});
+			break;
+		case CombatEventType::LOCATION_STATUS: {
+			const LocationStatus& loc = event.defender->locations[event.location];
+			addLogMessage(game, LogTemplate::LOCATION_STATUS, {locationToString(event.location), event.armor, loc.maxArmor, event.structure, loc.maxStructure});
+			break;
+		}
+		case CombatEventType::UNIT_DESTROYED:
+			addLogMessage(game, LogTemplate::UNIT_DESTROYED, {game.units.details(*event.defender).name, sideName(event.defender)});
+			break;
+		case CombatEventType::ATTACK_RESOLVED:
+			if (event.defender->isAlive())
+				addLogMessage(game, LogTemplate::UNIT_DAMAGED, {game.units.details(*event.defender).name, sideName(event.defender)});
+			addLogMessage(game, LogTemplate::SEPARATOR);
+			break;
+	}
+}
+
 } // namespace gamelogic
@@ -0,0 +1,80 @@
+#include "Visibility.hpp"
+
+#include <algorithm>
+
+namespace visibility {
+
+HexBitset::HexBitset()
+    : size_(0) {
+}
+
+void HexBitset::resize(int count) {
+	size_ = count;
+	words_.assign(((size_t)count + 63) / 64, 0);
+}
+
+void HexBitset::clear() {
+	std::fill(words_.begin(), words_.end(), 0);
+}
+
+int HexBitset::count() const {
+	int total = 0;
+	for (uint64_t word : words_) {
+		total += __builtin_popcountll(word);
+	}
+	return total;
+}
+
+bool HexBitset::any() const {
+	uint64_t acc = 0;
+	for (uint64_t word : words_) {
+		acc |= word;
+	}
+	return acc != 0;
+}
+
+void HexBitset::intersect(const HexBitset& a, const HexBitset& b, HexBitset& out) {
+	out.size_ = a.size_;
+	out.words_.resize(a.words_.size());
+	const uint64_t* wa = a.words_.data();
+	const uint64_t* wb = b.words_.data();
+	uint64_t* wo = out.words_.data();
+	for (size_t i = 0, n = a.words_.size(); i < n; i++) {
+		wo[i] = wa[i] & wb[i];
+	}
+}
+
+void HexBitset::unite(const HexBitset& a, const HexBitset& b, HexBitset& out) {
+	out.size_ = a.size_;
+	out.words_.resize(a.words_.size());
+	const uint64_t* wa = a.words_.data();
+	const uint64_t* wb = b.words_.data();
+	uint64_t* wo = out.words_.data();
+	for (size_t i = 0, n = a.words_.size(); i < n; i++) {
+		wo[i] = wa[i] | wb[i];
+	}
+}
+
+void HexBitset::subtract(const HexBitset& a, const HexBitset& b, HexBitset& out) {
+	out.size_ = a.size_;
+	out.words_.resize(a.words_.size());
+	const uint64_t* wa = a.words_.data();
+	const uint64_t* wb = b.words_.data();
+	uint64_t* wo = out.words_.data();
+	for (size_t i = 0, n = a.words_.size(); i < n; i++) {
+		wo[i] = wa[i] & ~wb[i];
+	}
+}
+
+void VisibilityLayer::resize(int count) {
+	visible_.resize(count);
+	turnStart_.resize(count);
+	spotters_.assign(count, 0);
+}
+
+void VisibilityLayer::clear() {
+	visible_.clear();
+	std::fill(spotters_.begin(), spotters_.end(), 0);
+}
+
+} // namespace visibility
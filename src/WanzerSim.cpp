@@ -0,0 +1,317 @@
+//==============================================================================
+// wanzer-sim - Headless batch battle simulator for balance runs
+//==============================================================================
+
+#include "AiPlayer.hpp"
+#include "BattleSim.hpp"
+#include "ThreadPool.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+const char* const kClassNames[] = {"LIGHT", "MEDIUM", "HEAVY", "ASSAULT"};
+
+struct Options {
+	long battles = 1000;
+	uint64_t seed = rng::kDefaultSeed;
+	int threads = 0;
+	bool json = false;
+	const char* policy[2] = {"scripted", "scripted"};
+	battlesim::BattleSetup setup;
+};
+
+// Results of the battles one worker played, merged at the end
+struct Totals {
+	long battles = 0;
+	long wins[2] = {0, 0};
+	long draws = 0;
+	long damage[2] = {0, 0};
+	std::vector<long> turnsToKill;      // Destroyed units by the turn they fell on
+	std::vector<long> firstKill;        // Battles with a kill by the turn of the first
+	std::vector<long> decisiveTurns;    // Decisive battles by end turn
+	std::vector<long> attackDamage[2];  // Attacks by damage dealt
+
+	void add(const battlesim::BattleResult& result) {
+		battles++;
+		if (result.winner < 0) {
+			draws++;
+		} else {
+			wins[result.winner]++;
+			count(decisiveTurns, result.turns);
+		}
+		int first = -1;
+		for (int side = 0; side < 2; side++) {
+			for (int turn : result.killTurns[side]) {
+				count(turnsToKill, turn);
+				if (first < 0 || turn < first)
+					first = turn;
+			}
+		}
+		if (first >= 0)
+			count(firstKill, first);
+		for (int side = 0; side < 2; side++) {
+			damage[side] += result.damageDealt[side];
+			for (int amount : result.attackDamage[side]) {
+				count(attackDamage[side], amount);
+			}
+		}
+	}
+
+	void merge(const Totals& other) {
+		battles += other.battles;
+		draws += other.draws;
+		for (int side = 0; side < 2; side++) {
+			wins[side] += other.wins[side];
+			damage[side] += other.damage[side];
+			mergeHistogram(attackDamage[side], other.attackDamage[side]);
+		}
+		mergeHistogram(turnsToKill, other.turnsToKill);
+		mergeHistogram(firstKill, other.firstKill);
+		mergeHistogram(decisiveTurns, other.decisiveTurns);
+	}
+
+	static void count(std::vector<long>& histogram, int value) {
+		value = std::max(value, 0);
+		if ((int)histogram.size() <= value)
+			histogram.resize(value + 1, 0);
+		histogram[value]++;
+	}
+
+	static void mergeHistogram(std::vector<long>& into, const std::vector<long>& from) {
+		if (into.size() < from.size())
+			into.resize(from.size(), 0);
+		for (size_t i = 0; i < from.size(); i++) {
+			into[i] += from[i];
+		}
+	}
+};
+
+void printUsage() {
+	std::fprintf(stderr,
+	             "Usage: wanzer-sim [options]\n"
+	             "  --battles N        Battles to play (default 1000)\n"
+	             "  --seed S           Base seed; battle i uses a seed derived from S and i\n"
+	             "  --threads N        Worker threads (default: all hardware threads)\n"
+	             "  --format csv|json  Output format (default csv)\n"
+	             "  --side0 CLASSES    Comma-separated unit classes, e.g. light,medium,heavy\n"
+	             "  --side1 CLASSES    (light, medium, heavy, assault)\n"
+	             "  --policy0 NAME     Who plays side 0: scripted or ai (default scripted)\n"
+	             "  --policy1 NAME     Who plays side 1\n"
+	             "  --max-turns N      Turns before a battle is a draw (default 20)\n");
+}
+
+bool parseClasses(const char* text, std::vector<UnitClass>& out) {
+	out.clear();
+	std::string list(text);
+	size_t start = 0;
+	while (start <= list.size()) {
+		size_t end = list.find(',', start);
+		if (end == std::string::npos)
+			end = list.size();
+		std::string name = list.substr(start, end - start);
+		for (char& c : name) {
+			c = (char)std::toupper((unsigned char)c);
+		}
+
+		bool found = false;
+		for (int i = 0; i < 4; i++) {
+			if (name == kClassNames[i]) {
+				out.push_back(static_cast<UnitClass>(i));
+				found = true;
+			}
+		}
+		if (!found)
+			return false;
+		start = end + 1;
+	}
+	return !out.empty();
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+	options.setup.units[0] = {UnitClass::LIGHT, UnitClass::MEDIUM, UnitClass::HEAVY};
+	options.setup.units[1] = {UnitClass::LIGHT, UnitClass::MEDIUM, UnitClass::ASSAULT};
+
+	for (int i = 1; i < argc; i++) {
+		const char* arg = argv[i];
+		const char* value = i + 1 < argc ? argv[i + 1] : nullptr;
+		if (std::strcmp(arg, "--help") == 0 || std::strcmp(arg, "-h") == 0)
+			return false;
+		if (!value) {
+			std::fprintf(stderr, "Missing value for %s\n", arg);
+			return false;
+		}
+		i++;
+
+		if (std::strcmp(arg, "--battles") == 0) {
+			options.battles = std::strtol(value, nullptr, 10);
+		} else if (std::strcmp(arg, "--seed") == 0) {
+			options.seed = std::strtoull(value, nullptr, 0);
+		} else if (std::strcmp(arg, "--threads") == 0) {
+			options.threads = (int)std::strtol(value, nullptr, 10);
+		} else if (std::strcmp(arg, "--format") == 0) {
+			if (std::strcmp(value, "json") != 0 && std::strcmp(value, "csv") != 0) {
+				std::fprintf(stderr, "Unknown format: %s\n", value);
+				return false;
+			}
+			options.json = std::strcmp(value, "json") == 0;
+		} else if (std::strcmp(arg, "--side0") == 0 || std::strcmp(arg, "--side1") == 0) {
+			int side = arg[6] - '0';
+			if (!parseClasses(value, options.setup.units[side])) {
+				std::fprintf(stderr, "Bad unit list: %s\n", value);
+				return false;
+			}
+		} else if (std::strcmp(arg, "--policy0") == 0 || std::strcmp(arg, "--policy1") == 0) {
+			int side = arg[8] - '0';
+			if (std::strcmp(value, "scripted") == 0) {
+				options.setup.policy[side] = battlesim::playScriptedTurn;
+			} else if (std::strcmp(value, "ai") == 0) {
+				options.setup.policy[side] = ai::playAiTurn;
+			} else {
+				std::fprintf(stderr, "Unknown policy: %s\n", value);
+				return false;
+			}
+			options.policy[side] = value;
+		} else if (std::strcmp(arg, "--max-turns") == 0) {
+			options.setup.maxTurns = (int)std::strtol(value, nullptr, 10);
+		} else {
+			std::fprintf(stderr, "Unknown option: %s\n", arg);
+			return false;
+		}
+	}
+	return options.battles > 0 && options.setup.maxTurns > 0;
+}
+
+std::string classList(const std::vector<UnitClass>& units) {
+	std::string out;
+	for (UnitClass unitClass : units) {
+		if (!out.empty())
+			out += ',';
+		out += kClassNames[static_cast<int>(unitClass)];
+	}
+	return out;
+}
+
+double mean(const std::vector<long>& histogram) {
+	long count = 0;
+	double sum = 0.0;
+	for (size_t i = 0; i < histogram.size(); i++) {
+		count += histogram[i];
+		sum += (double)i * histogram[i];
+	}
+	return count > 0 ? sum / count : 0.0;
+}
+
+void printHistogramJson(const std::vector<long>& histogram) {
+	std::printf("{");
+	bool first = true;
+	for (size_t i = 0; i < histogram.size(); i++) {
+		if (histogram[i] == 0)
+			continue;
+		std::printf("%s\"%zu\": %ld", first ? "" : ", ", i, histogram[i]);
+		first = false;
+	}
+	std::printf("}");
+}
+
+void printJson(const Options& options, const Totals& totals) {
+	std::printf("{\n");
+	std::printf("  \"battles\": %ld,\n", totals.battles);
+	std::printf("  \"seed\": %llu,\n", (unsigned long long)options.seed);
+	std::printf("  \"maxTurns\": %d,\n", options.setup.maxTurns);
+	std::printf("  \"draws\": %ld,\n", totals.draws);
+	std::printf("  \"sides\": [\n");
+	for (int side = 0; side < 2; side++) {
+		std::printf("    {\"units\": \"%s\", \"policy\": \"%s\", \"wins\": %ld, \"winRate\": %.6f, \"meanDamagePerBattle\": %.3f, "
+		            "\"meanDamagePerAttack\": %.3f, \"attackDamage\": ",
+		            classList(options.setup.units[side]).c_str(), options.policy[side], totals.wins[side],
+		            (double)totals.wins[side] / totals.battles, (double)totals.damage[side] / totals.battles,
+		            mean(totals.attackDamage[side]));
+		printHistogramJson(totals.attackDamage[side]);
+		std::printf("}%s\n", side == 0 ? "," : "");
+	}
+	std::printf("  ],\n");
+	std::printf("  \"turnsToKill\": {\"mean\": %.3f, \"meanFirst\": %.3f, \"histogram\": ", mean(totals.turnsToKill),
+	            mean(totals.firstKill));
+	printHistogramJson(totals.turnsToKill);
+	std::printf("},\n");
+	std::printf("  \"decisiveBattleTurns\": {\"mean\": %.3f, \"histogram\": ", mean(totals.decisiveTurns));
+	printHistogramJson(totals.decisiveTurns);
+	std::printf("}\n}\n");
+}
+
+void printCsv(const Options& options, const Totals& totals) {
+	std::printf("section,side,key,value\n");
+	std::printf("summary,,battles,%ld\n", totals.battles);
+	std::printf("summary,,seed,%llu\n", (unsigned long long)options.seed);
+	std::printf("summary,,draws,%ld\n", totals.draws);
+	for (int side = 0; side < 2; side++) {
+		std::printf("summary,%d,units,\"%s\"\n", side, classList(options.setup.units[side]).c_str());
+		std::printf("summary,%d,policy,%s\n", side, options.policy[side]);
+		std::printf("summary,%d,wins,%ld\n", side, totals.wins[side]);
+		std::printf("summary,%d,win_rate,%.6f\n", side, (double)totals.wins[side] / totals.battles);
+		std::printf("summary,%d,mean_damage_per_battle,%.3f\n", side, (double)totals.damage[side] / totals.battles);
+		std::printf("summary,%d,mean_damage_per_attack,%.3f\n", side, mean(totals.attackDamage[side]));
+	}
+	std::printf("summary,,mean_turns_to_kill,%.3f\n", mean(totals.turnsToKill));
+	std::printf("summary,,mean_turns_to_first_kill,%.3f\n", mean(totals.firstKill));
+	std::printf("summary,,mean_decisive_battle_turns,%.3f\n", mean(totals.decisiveTurns));
+	for (size_t turn = 0; turn < totals.turnsToKill.size(); turn++) {
+		if (totals.turnsToKill[turn] > 0)
+			std::printf("turns_to_kill,,%zu,%ld\n", turn, totals.turnsToKill[turn]);
+	}
+	for (size_t turn = 0; turn < totals.decisiveTurns.size(); turn++) {
+		if (totals.decisiveTurns[turn] > 0)
+			std::printf("decisive_battle_turns,,%zu,%ld\n", turn, totals.decisiveTurns[turn]);
+	}
+	for (int side = 0; side < 2; side++) {
+		const std::vector<long>& histogram = totals.attackDamage[side];
+		for (size_t amount = 0; amount < histogram.size(); amount++) {
+			if (histogram[amount] > 0)
+				std::printf("attack_damage,%d,%zu,%ld\n", side, amount, histogram[amount]);
+		}
+	}
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+	Options options;
+	if (!parseOptions(argc, argv, options)) {
+		printUsage();
+		return 1;
+	}
+
+	ThreadPool pool(options.threads);
+	std::vector<Totals> perWorker(pool.size());
+
+	auto start = std::chrono::steady_clock::now();
+	// Battle i always gets the same seed, so totals don't depend on which
+	// worker played it
+	pool.parallelFor((int)options.battles, [&](int battle, int worker) {
+		uint64_t seed = battlesim::battleSeed(options.seed, (uint64_t)battle);
+		perWorker[worker].add(battlesim::runBattle(options.setup, seed));
+	});
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	Totals totals;
+	for (const Totals& worker : perWorker) {
+		totals.merge(worker);
+	}
+
+	if (options.json)
+		printJson(options, totals);
+	else
+		printCsv(options, totals);
+
+	std::fprintf(stderr, "%ld battles on %d threads in %.2fs (%.0f battles/s)\n", totals.battles, pool.size(), seconds,
+	             totals.battles / std::max(seconds, 1e-9));
+	return 0;
+}